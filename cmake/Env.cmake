@@ -172,6 +172,8 @@ if(OB_BUILD_ARBITRATION)
   add_definitions(-DOB_BUILD_ARBITRATION)
 endif()
 
+# 日志存储压缩, 开源模式使用src/logservice/ob_log_compression.cpp
+ob_define(OB_BUILD_LOG_STORAGE_COMPRESS ON)
 if(OB_BUILD_LOG_STORAGE_COMPRESS)
   add_definitions(-DOB_BUILD_LOG_STORAGE_COMPRESS)
 endif()
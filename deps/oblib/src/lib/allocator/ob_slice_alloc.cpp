@@ -46,8 +46,161 @@ void ObBlockSlicer::print_leak_slice() {
   }
 }
 
+int ObSliceAlloc::enable_magazine()
+{
+  int ret = OB_SUCCESS;
+  const int64_t slot_cnt = std::min(get_max_icpu_id(), OB_MAX_CPU_NUM);
+  const int64_t buf_size = sizeof(MagazineSlot) * slot_cnt + CACHE_ALIGN_SIZE;
+  void *buf = NULL;
+  if (OB_NOT_NULL(mag_slots_)) {
+    ret = OB_INIT_TWICE;
+    LIB_LOG(WARN, "magazine is enabled twice", K(ret), KPC(this));
+  } else if (OB_UNLIKELY(0 == bsize_ || slot_cnt <= 0)) {
+    ret = OB_NOT_INIT;
+    LIB_LOG(WARN, "slice alloc is not inited", K(ret), K(slot_cnt), KPC(this));
+  } else if (OB_ISNULL(buf = blk_alloc_.alloc_block(buf_size, attr_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LIB_LOG(WARN, "alloc magazine slots failed", K(ret), K(buf_size), KPC(this));
+  } else {
+    MagazineSlot *slots = (MagazineSlot *)lib::align_up2((uint64_t)buf, CACHE_ALIGN_SIZE);
+    for (int64_t i = 0; i < slot_cnt; i++) {
+      new (slots + i) MagazineSlot();
+    }
+    mag_slots_buf_ = buf;
+    mag_slot_cnt_ = slot_cnt;
+    ATOMIC_STORE(&mag_slots_, slots);
+    LIB_LOG(INFO, "slice alloc magazine enabled", K(slot_cnt), KPC(this));
+  }
+  return ret;
+}
+
+void ObSliceAlloc::purge_magazine()
+{
+  Magazine *mags = NULL;
+  auto take = [&mags](Magazine *mag) {
+    if (OB_NOT_NULL(mag)) {
+      mag->next_ = mags;
+      mags = mag;
+    }
+  };
+  for (int64_t i = 0; OB_NOT_NULL(mag_slots_) && i < mag_slot_cnt_; i++) {
+    MagazineSlot &slot = mag_slots_[i];
+    slot.lock();
+    take(slot.loaded_);
+    take(slot.prev_);
+    slot.loaded_ = NULL;
+    slot.prev_ = NULL;
+    slot.unlock();
+  }
+  {
+    lib::ObLockGuard<common::ObSpinLock> guard(depot_lock_);
+    while (OB_NOT_NULL(full_mags_)) {
+      Magazine *mag = full_mags_;
+      full_mags_ = mag->next_;
+      take(mag);
+    }
+    while (OB_NOT_NULL(empty_mags_)) {
+      Magazine *mag = empty_mags_;
+      empty_mags_ = mag->next_;
+      take(mag);
+    }
+    full_mag_cnt_ = 0;
+  }
+  // the magazines are detached, the slots reload new ones on demand
+  while (OB_NOT_NULL(mags)) {
+    Magazine *mag = mags;
+    mags = mags->next_;
+    flush_magazine(mag);
+    blk_alloc_.free_block(mag, sizeof(Magazine));
+  }
+}
+
+ObSliceAlloc::Magazine *ObSliceAlloc::pop_full_magazine()
+{
+  Magazine *mag = NULL;
+  lib::ObLockGuard<common::ObSpinLock> guard(depot_lock_);
+  if (OB_NOT_NULL(full_mags_)) {
+    mag = full_mags_;
+    full_mags_ = mag->next_;
+    mag->next_ = NULL;
+    full_mag_cnt_--;
+  }
+  return mag;
+}
+
+void ObSliceAlloc::push_full_magazine(Magazine *mag)
+{
+  if (OB_NOT_NULL(mag)) {
+    bool is_depot_full = false;
+    {
+      lib::ObLockGuard<common::ObSpinLock> guard(depot_lock_);
+      // the depot keeps at most one full magazine per slot, the others are returned to blocks
+      // so that the cached items are bounded.
+      if (full_mag_cnt_ >= mag_slot_cnt_) {
+        is_depot_full = true;
+      } else {
+        mag->next_ = full_mags_;
+        full_mags_ = mag;
+        full_mag_cnt_++;
+      }
+    }
+    if (is_depot_full) {
+      flush_magazine(mag);
+      push_empty_magazine(mag);
+    }
+  }
+}
+
+ObSliceAlloc::Magazine *ObSliceAlloc::pop_empty_magazine()
+{
+  Magazine *mag = NULL;
+  {
+    lib::ObLockGuard<common::ObSpinLock> guard(depot_lock_);
+    if (OB_NOT_NULL(empty_mags_)) {
+      mag = empty_mags_;
+      empty_mags_ = mag->next_;
+      mag->next_ = NULL;
+    }
+  }
+  if (OB_ISNULL(mag)) {
+    void *ptr = NULL;
+    if (OB_NOT_NULL(ptr = blk_alloc_.alloc_block(sizeof(Magazine), attr_))) {
+      mag = new (ptr) Magazine();
+    }
+  }
+  return mag;
+}
+
+void ObSliceAlloc::push_empty_magazine(Magazine *mag)
+{
+  if (OB_NOT_NULL(mag)) {
+    lib::ObLockGuard<common::ObSpinLock> guard(depot_lock_);
+    mag->next_ = empty_mags_;
+    empty_mags_ = mag;
+  }
+}
+
+void ObSliceAlloc::flush_magazine(Magazine *mag)
+{
+  while (OB_NOT_NULL(mag) && !mag->is_empty()) {
+    free_to_block(mag->pop());
+  }
+}
+
+void ObSliceAlloc::destroy_magazine()
+{
+  if (OB_NOT_NULL(mag_slots_)) {
+    purge_magazine();
+    blk_alloc_.free_block(mag_slots_buf_, sizeof(MagazineSlot) * mag_slot_cnt_ + CACHE_ALIGN_SIZE);
+    mag_slots_ = NULL;
+    mag_slots_buf_ = NULL;
+    mag_slot_cnt_ = 0;
+  }
+}
+
 void ObSliceAlloc::destroy()
 {
+  destroy_magazine();
   for (int i = MAX_ARENA_NUM - 1; i >= 0; i--) {
     Arena &arena = arena_[i];
     Block *old_blk = arena.clear();
@@ -17,6 +17,7 @@
 #include "lib/lock/ob_lock_guard.h"
 #include "lib/allocator/ob_block_alloc_mgr.h"
 #include "lib/allocator/ob_qsync.h"
+#include "lib/thread_local/ob_tsi_utils.h"
 #include "lib/utility/ob_print_utils.h"
 
 namespace oceanbase
@@ -294,10 +295,42 @@ class ObSliceAlloc
 {
 public:
   enum { MAX_ARENA_NUM = 32, MAX_REF_NUM = 128, DEFAULT_BLOCK_SIZE = OB_MALLOC_NORMAL_BLOCK_SIZE };
+  enum { MAGAZINE_SIZE = 32 };
   typedef ObSimpleSync Sync;
   typedef ObBlockSlicer Block;
   typedef ObBlockAllocMgr BlockAlloc;
   typedef ObDListWithLock BlockList;
+  // A magazine is a bounded stack of free items, it is exchanged with the depot as a whole.
+  struct Magazine
+  {
+    Magazine(): next_(NULL), cnt_(0) {}
+    bool is_full() const { return cnt_ >= MAGAZINE_SIZE; }
+    bool is_empty() const { return 0 == cnt_; }
+    void push(Block::Item* item) { items_[cnt_++] = item; }
+    Block::Item* pop() { return items_[--cnt_]; }
+    Magazine* next_;
+    int64_t cnt_;
+    Block::Item* items_[MAGAZINE_SIZE];
+  };
+  // Per-cpu cache of free items. loaded_ serves alloc and free first, prev_ absorbs the
+  // alloc/free oscillation around the magazine boundary without going to the depot.
+  class MagazineSlot
+  {
+  public:
+    MagazineSlot(): lock_(ObLatchIds::OB_DLIST_LOCK), loaded_(NULL), prev_(NULL) {}
+    void lock() { lock_.lock(); }
+    void unlock() { lock_.unlock(); }
+    void swap() {
+      Magazine* tmp = loaded_;
+      loaded_ = prev_;
+      prev_ = tmp;
+    }
+  private:
+    mutable common::ObSpinLock lock_;
+  public:
+    Magazine* loaded_;
+    Magazine* prev_;
+  } CACHE_ALIGNED;
   class Arena
   {
   public:
@@ -312,11 +345,15 @@ public:
     Block* blk_;
   } CACHE_ALIGNED;
   ObSliceAlloc(): nway_(0), bsize_(0), isize_(0),
-                  slice_limit_(0), blk_alloc_(default_blk_alloc), tmallocator_(NULL) {}
+                  slice_limit_(0), blk_alloc_(default_blk_alloc), tmallocator_(NULL),
+                  mag_slots_buf_(NULL), mag_slots_(NULL), mag_slot_cnt_(0), depot_lock_(ObLatchIds::OB_DLIST_LOCK),
+                  full_mags_(NULL), empty_mags_(NULL), full_mag_cnt_(0) {}
   ObSliceAlloc(const int size, const ObMemAttr &attr, int block_size=DEFAULT_BLOCK_SIZE,
       BlockAlloc &blk_alloc = default_blk_alloc, void* tmallocator = NULL)
     : nway_(1), bsize_(block_size), isize_(size), attr_(attr),
-      blk_alloc_(blk_alloc), tmallocator_(tmallocator) {
+      blk_alloc_(blk_alloc), tmallocator_(tmallocator),
+      mag_slots_buf_(NULL), mag_slots_(NULL), mag_slot_cnt_(0), depot_lock_(ObLatchIds::OB_DLIST_LOCK),
+      full_mags_(NULL), empty_mags_(NULL), full_mag_cnt_(0) {
       slice_limit_ = block_size - (int32_t)sizeof(Block) - (int32_t)sizeof(Block::Item);
       LIB_LOG(INFO, "ObSliceAlloc init finished", K(bsize_), K(isize_), K(slice_limit_), KP(tmallocator_));
     }
@@ -329,6 +366,14 @@ public:
     return ret;
   }
   void destroy();
+  // Cache free items in per-cpu magazines, so that the hot alloc/free path does not touch
+  // the shared block and arena. The items cached stay in their blocks and the magazines
+  // are allocated from blk_alloc_ with attr_, so the memory is attributed as before.
+  // It should be called once after init and before any alloc.
+  int enable_magazine();
+  // Return all the cached items to their blocks and free the magazines, only the slots
+  // allocated by enable_magazine() are kept until destroy().
+  void purge_magazine();
   void set_nway(int nway) {
     if (nway <= 0) {
       nway = 1;
@@ -349,6 +394,61 @@ public:
 #ifdef OB_USE_ASAN
     return ::malloc(isize_);
 #else
+    Block::Item* ret = NULL;
+    if (NULL != mag_slots_ && NULL != (ret = alloc_from_magazine())) {
+      ret->MAGIC_CODE_ = Block::ITEM_MAGIC_CODE;
+    } else {
+      ret = alloc_from_block();
+    }
+
+    GEN_RECORD_ALL_LBT_IN_THIS_ALLOCATOR_CODE
+    return NULL == ret? NULL: (void*)(ret + 1);
+#endif
+  }
+  void free(void* p) {
+#ifdef OB_USE_ASAN
+    ::free(p);
+#else
+    if (NULL != p) {
+      Block::Item* item = (Block::Item*)p - 1;
+      abort_unless(Block::ITEM_MAGIC_CODE == item->MAGIC_CODE_);
+      Block* blk = item->host_;
+#ifndef NDEBUG
+      abort_unless(blk->get_slice_alloc() == this);
+      abort_unless(bsize_ != 0);
+#else
+      if (this != blk->get_slice_alloc()) {
+        LIB_LOG_RET(ERROR, OB_ERR_UNEXPECTED, "blk is freed or alloced by different slice_alloc", K(this), K(blk->get_slice_alloc()));
+        return;
+      }
+#endif
+      item->MAGIC_CODE_ = item->MAGIC_CODE_ & Block::ITEM_MAGIC_CODE_MASK;
+      if (NULL == mag_slots_ || !free_to_magazine(item)) {
+        free_to_block(item);
+      }
+    }
+#endif
+  }
+  void purge_extra_cached_block(int keep) {
+    for(int i = MAX_ARENA_NUM - 1; i >= keep; i--) {
+      Arena& arena = arena_[i];
+      Block* old_blk = arena.clear();
+      if (NULL != old_blk) {
+        blk_ref_[ObBlockSlicer::hash((uint64_t)old_blk) % MAX_REF_NUM].sync();
+        release_block(old_blk);
+      }
+    }
+  }
+  int64_t to_string(char *buf, const int64_t limit) const
+  {
+    return snprintf(buf, limit, "SliceAlloc: nway=%d bsize/isize=%d/%d limit=%d attr=%s",
+                    nway_, bsize_, isize_, slice_limit_, to_cstring(attr_));
+  }
+  int32_t get_bsize() { return bsize_; }
+  int32_t get_isize() { return isize_; }
+
+private:
+  Block::Item* alloc_from_block() {
     Block::Item* ret = NULL;
     int tmp_ret = OB_SUCCESS;
     if (isize_ > slice_limit_) {
@@ -393,58 +493,69 @@ public:
         }
       }
     }
-
-    GEN_RECORD_ALL_LBT_IN_THIS_ALLOCATOR_CODE
-    return NULL == ret? NULL: (void*)(ret + 1);
-#endif
+    return ret;
   }
-  void free(void* p) {
-#ifdef OB_USE_ASAN
-    ::free(p);
-#else
-    if (NULL != p) {
-      Block::Item* item = (Block::Item*)p - 1;
-      abort_unless(Block::ITEM_MAGIC_CODE == item->MAGIC_CODE_);
-      Block* blk = item->host_;
-#ifndef NDEBUG
-      abort_unless(blk->get_slice_alloc() == this);
-      abort_unless(bsize_ != 0);
-#else
-      if (this != blk->get_slice_alloc()) {
-        LIB_LOG_RET(ERROR, OB_ERR_UNEXPECTED, "blk is freed or alloced by different slice_alloc", K(this), K(blk->get_slice_alloc()));
-        return;
-      }
-#endif
-      item->MAGIC_CODE_ = item->MAGIC_CODE_ & Block::ITEM_MAGIC_CODE_MASK;
-      bool first_free = false;
-      bool need_destroy = blk->free_item(item, first_free);
-      if (need_destroy) {
-        destroy_block(blk);
-      } else if (first_free) {
-        add_to_blist(blk);
-      }
+  void free_to_block(Block::Item* item) {
+    Block* blk = item->host_;
+    bool first_free = false;
+    bool need_destroy = blk->free_item(item, first_free);
+    if (need_destroy) {
+      destroy_block(blk);
+    } else if (first_free) {
+      add_to_blist(blk);
     }
-#endif
   }
-  void purge_extra_cached_block(int keep) {
-    for(int i = MAX_ARENA_NUM - 1; i >= keep; i--) {
-      Arena& arena = arena_[i];
-      Block* old_blk = arena.clear();
-      if (NULL != old_blk) {
-        blk_ref_[ObBlockSlicer::hash((uint64_t)old_blk) % MAX_REF_NUM].sync();
-        release_block(old_blk);
+  Block::Item* alloc_from_magazine() {
+    Block::Item* ret = NULL;
+    MagazineSlot& slot = mag_slots_[icpu_id() % mag_slot_cnt_];
+    slot.lock();
+    if (NULL != slot.loaded_ && !slot.loaded_->is_empty()) {
+      ret = slot.loaded_->pop();
+    } else if (NULL != slot.prev_ && !slot.prev_->is_empty()) {
+      slot.swap();
+      ret = slot.loaded_->pop();
+    } else {
+      Magazine* full = pop_full_magazine();
+      if (NULL != full) {
+        push_empty_magazine(slot.prev_);
+        slot.prev_ = slot.loaded_;
+        slot.loaded_ = full;
+        ret = slot.loaded_->pop();
       }
     }
+    slot.unlock();
+    return ret;
   }
-  int64_t to_string(char *buf, const int64_t limit) const
-  {
-    return snprintf(buf, limit, "SliceAlloc: nway=%d bsize/isize=%d/%d limit=%d attr=%s",
-                    nway_, bsize_, isize_, slice_limit_, to_cstring(attr_));
-  }
-  int32_t get_bsize() { return bsize_; }
-  int32_t get_isize() { return isize_; }
-
-private:
+  bool free_to_magazine(Block::Item* item) {
+    bool bret = false;
+    MagazineSlot& slot = mag_slots_[icpu_id() % mag_slot_cnt_];
+    slot.lock();
+    if (NULL != slot.loaded_ && !slot.loaded_->is_full()) {
+      slot.loaded_->push(item);
+      bret = true;
+    } else if (NULL != slot.prev_ && !slot.prev_->is_full()) {
+      slot.swap();
+      slot.loaded_->push(item);
+      bret = true;
+    } else {
+      Magazine* empty = pop_empty_magazine();
+      if (NULL != empty) {
+        push_full_magazine(slot.prev_);
+        slot.prev_ = slot.loaded_;
+        slot.loaded_ = empty;
+        slot.loaded_->push(item);
+        bret = true;
+      }
+    }
+    slot.unlock();
+    return bret;
+  }
+  Magazine* pop_full_magazine();
+  void push_full_magazine(Magazine* mag);
+  Magazine* pop_empty_magazine();
+  void push_empty_magazine(Magazine* mag);
+  void flush_magazine(Magazine* mag);
+  void destroy_magazine();
   void release_block(Block* blk) {
     if (blk->release()) {
       add_to_blist(blk);
@@ -503,6 +614,15 @@ protected:
   Sync blk_ref_[MAX_REF_NUM];
   BlockAlloc &blk_alloc_;
   void* tmallocator_;
+  // magazine layer, NULL if it is not enabled
+  void* mag_slots_buf_;
+  MagazineSlot* mag_slots_;
+  int64_t mag_slot_cnt_;
+  // depot of the magazines which are not loaded by any slot
+  common::ObSpinLock depot_lock_ CACHE_ALIGNED;
+  Magazine* full_mags_;
+  Magazine* empty_mags_;
+  int64_t full_mag_cnt_;
 
 /******************************************** debug code *********************************************/
 
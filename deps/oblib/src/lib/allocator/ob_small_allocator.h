@@ -57,7 +57,7 @@ public:
     }
     return ret;
   }
-  int destroy() { purge_extra_cached_block(0); return OB_SUCCESS; }
+  int destroy() { purge_magazine(); purge_extra_cached_block(0); return OB_SUCCESS; }
 private:
   BlockAlloc block_alloc_;
 };
@@ -11,11 +11,32 @@
  */
 
 #include "lib/ash/ob_active_session_guard.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/thread/thread.h"
 
 using namespace oceanbase::common;
 
 ActiveSessionStat ObActiveSessionGuard::dummy_stat_;
 thread_local ActiveSessionStat ObActiveSessionGuard::thread_local_stat_;
+ObActiveSessionThreadSlots::Slot *ObActiveSessionThreadSlots::segments_[ObActiveSessionThreadSlots::MAX_SEGMENT_COUNT];
+int64_t ObActiveSessionThreadSlots::slot_cnt_ = 0;
+
+namespace
+{
+struct ObAshThreadSlotHolder
+{
+  ObAshThreadSlotHolder() : slot_idx_(-1), stat_(nullptr) {}
+  ~ObAshThreadSlotHolder()
+  {
+    if (slot_idx_ >= 0) {
+      ObActiveSessionThreadSlots::release(slot_idx_);
+      slot_idx_ = -1;
+    }
+  }
+  int64_t slot_idx_;
+  ActiveSessionStat *stat_;
+};
+}
 
 ActiveSessionStat *&ObActiveSessionGuard::get_stat_ptr()
 {
@@ -42,5 +63,87 @@ void ObActiveSessionGuard::setup_ash(ActiveSessionStat &stat)
 
 void ObActiveSessionGuard::setup_thread_local_ash()
 {
-  get_stat_ptr() = &thread_local_stat_;
+  get_stat_ptr() = &get_thread_stat();
+}
+
+ActiveSessionStat &ObActiveSessionGuard::get_thread_stat()
+{
+  static thread_local ObAshThreadSlotHolder holder;
+  if (OB_UNLIKELY(nullptr == holder.stat_)) {
+    holder.slot_idx_ = ObActiveSessionThreadSlots::acquire();
+    if (holder.slot_idx_ >= 0) {
+      holder.stat_ = &ObActiveSessionThreadSlots::get(holder.slot_idx_);
+    } else {
+      // no free slot, this thread will not be sampled
+      holder.stat_ = &thread_local_stat_;
+      if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+        LIB_LOG_RET(WARN, OB_SIZE_OVERFLOW, "no free ash thread slot, this thread will not be sampled",
+                    "slot_count", ObActiveSessionThreadSlots::slot_count(),
+                    "max_slot_count", ObActiveSessionThreadSlots::max_slot_count());
+      }
+    }
+  }
+  return *holder.stat_;
+}
+
+int64_t ObActiveSessionThreadSlots::max_slot_count()
+{
+  return std::min(static_cast<int64_t>(lib::get_max_thread_num()), MAX_SLOT_COUNT);
+}
+
+ObActiveSessionThreadSlots::Slot *ObActiveSessionThreadSlots::get_or_alloc_segment(const int64_t seg_idx)
+{
+  Slot *seg = ATOMIC_LOAD(&segments_[seg_idx]);
+  if (OB_ISNULL(seg)) {
+    void *buf = NULL;
+    ObMemAttr attr(OB_SERVER_TENANT_ID, "AshThreadSlot");
+    if (OB_ISNULL(buf = ob_malloc(sizeof(Slot) * SEGMENT_SIZE, attr))) {
+      LIB_LOG_RET(WARN, OB_ALLOCATE_MEMORY_FAILED, "alloc ash thread slot segment failed", K(seg_idx));
+    } else {
+      Slot *new_seg = static_cast<Slot *>(buf);
+      for (int64_t i = 0; i < SEGMENT_SIZE; i++) {
+        new (new_seg + i) Slot();
+      }
+      if (ATOMIC_BCAS(&segments_[seg_idx], NULL, new_seg)) {
+        seg = new_seg;
+      } else {
+        // allocated by another thread
+        ob_free(buf);
+        seg = ATOMIC_LOAD(&segments_[seg_idx]);
+      }
+    }
+  }
+  return seg;
+}
+
+int64_t ObActiveSessionThreadSlots::acquire()
+{
+  int64_t idx = -1;
+  const int64_t max_cnt = max_slot_count();
+  Slot *seg = NULL;
+  for (int64_t i = 0; idx < 0 && i < max_cnt; i++) {
+    if (0 == i % SEGMENT_SIZE && OB_ISNULL(seg = get_or_alloc_segment(i / SEGMENT_SIZE))) {
+      break;
+    } else {
+      Slot &slot = seg[i % SEGMENT_SIZE];
+      if (!ATOMIC_LOAD(&slot.used_) && ATOMIC_BCAS(&slot.used_, false, true)) {
+        idx = i;
+        inc_update(&slot_cnt_, i + 1);
+      }
+    }
+  }
+  return idx;
+}
+
+void ObActiveSessionThreadSlots::release(const int64_t idx)
+{
+  if (idx >= 0 && idx < slot_count()) {
+    Slot &slot = get_slot(idx);
+    ActiveSessionStat &stat = slot.stat_;
+    if (&ObActiveSessionGuard::get_stat() == &stat) {
+      ObActiveSessionGuard::setup_default_ash();
+    }
+    stat.reuse();
+    ATOMIC_STORE(&slot.used_, false);
+  }
 }
@@ -18,6 +18,7 @@
 #include "lib/utility/ob_print_utils.h"
 #include "lib/wait_event/ob_wait_event.h"
 #include "lib/profile/ob_trace_id.h"
+#include "lib/atomic/ob_atomic.h"
 namespace oceanbase
 {
 namespace common
@@ -149,14 +150,56 @@ public:
   // set ash_stat in session to the thread local ash_stat_
   static void setup_ash(ActiveSessionStat &stat);
   static ActiveSessionStat &get_stat();
+  // set the stat of this thread to the thread local ash_stat_, used by threads running without
+  // session. The stat lives in ObActiveSessionThreadSlots if there is a free slot.
   static void setup_thread_local_ash();
   static thread_local ActiveSessionStat thread_local_stat_;
 private:
   static ActiveSessionStat dummy_stat_;
   static ActiveSessionStat *&get_stat_ptr();
+  static ActiveSessionStat &get_thread_stat();
   DISALLOW_COPY_AND_ASSIGN(ObActiveSessionGuard);
 };
 
+// Stats of threads running without session (e.g. remote das execution).
+// They are kept in a static table instead of thread local storage, so that the sampler only
+// scans the slots ever used and never reads memory of a thread which may have exited.
+// A slot is acquired the first time its thread calls `setup_thread_local_ash` and released
+// when the thread exits.
+// The table is made of segments which are allocated on demand and never freed, the number of
+// slots is bounded by the configured thread limit (lib::get_max_thread_num()) and MAX_SLOT_COUNT.
+class ObActiveSessionThreadSlots
+{
+public:
+  static const int64_t SEGMENT_SIZE = 1024;
+  static const int64_t MAX_SEGMENT_COUNT = 64;
+  static const int64_t MAX_SLOT_COUNT = SEGMENT_SIZE * MAX_SEGMENT_COUNT;
+  // return -1 if all slots are in use
+  static int64_t acquire();
+  static void release(const int64_t idx);
+  // high water mark of used slots, slots after it have never been used
+  static int64_t slot_count() { return ATOMIC_LOAD(&slot_cnt_); }
+  // upper limit of slots, derived from the configured thread limit
+  static int64_t max_slot_count();
+  static bool is_used(const int64_t idx) { return ATOMIC_LOAD(&get_slot(idx).used_); }
+  static ActiveSessionStat &get(const int64_t idx) { return get_slot(idx).stat_; }
+private:
+  struct Slot
+  {
+    Slot() : stat_(), used_(false) {}
+    ActiveSessionStat stat_;
+    bool used_;
+  } CACHE_ALIGNED;
+  // idx must be less than slot_count(), whose segment is always allocated
+  static Slot &get_slot(const int64_t idx)
+  {
+    return ATOMIC_LOAD(&segments_[idx / SEGMENT_SIZE])[idx % SEGMENT_SIZE];
+  }
+  static Slot *get_or_alloc_segment(const int64_t seg_idx);
+  static Slot *segments_[MAX_SEGMENT_COUNT];
+  static int64_t slot_cnt_;
+};
+
 
 #define DEF_ASH_FLAGS_SETTER_GUARD(ash_flag_type)                                                  \
   class ObActiveSession_##ash_flag_type##_FlagSetterGuard                                          \
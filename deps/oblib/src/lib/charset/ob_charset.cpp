@@ -12,6 +12,7 @@
 
 #define USING_LOG_PREFIX LIB_CHARSET
 #include "lib/charset/ob_charset.h"
+#include "lib/charset/str_uca_type.h"
 #include "lib/utility/serialization.h"
 #include "lib/ob_define.h"
 #include "lib/worker.h"
@@ -2459,6 +2460,22 @@ bool ObCharset::is_ci_collate(ObCollationType collation_type)
   return ret;
 }
 
+bool ObCharset::is_uca_900_nopad(ObCollationType collation_type)
+{
+  bool ret = false;
+  if (OB_UNLIKELY(collation_type <= CS_TYPE_INVALID ||
+                  collation_type >= CS_TYPE_MAX) ||
+                  OB_ISNULL(ObCharset::charset_arr[collation_type])) {
+    // not a valid collation, just return false
+  } else {
+    ObCharsetInfo *cs = static_cast<ObCharsetInfo *>(ObCharset::charset_arr[collation_type]);
+    ret = NULL != cs->uca && UCA_V900 == cs->uca->version
+          && NO_PAD == cs->pad_attribute
+          && NULL != cs->coll && NULL != cs->coll->strnxfrm_varlen;
+  }
+  return ret;
+}
+
 ObCharsetType ObCharset::default_charset_type_ = CHARSET_UTF8MB4;
 ObCollationType ObCharset::default_collation_type_ = CS_TYPE_UTF8MB4_GENERAL_CI;
 
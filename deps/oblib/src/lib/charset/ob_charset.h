@@ -604,6 +604,9 @@ public:
   static bool is_bin_sort(ObCollationType collation_type);
 
   static bool is_ci_collate(ObCollationType collation_type);
+  // UCA 9.0.0 NO PAD collations, such as utf8mb4_0900_ai_ci, whose weight strings
+  // can be compared by memcmp() directly
+  static bool is_uca_900_nopad(ObCollationType collation_type);
 
   static ObCollationType get_bin_collation(const ObCharsetType charset_type);
   static int first_valid_char(const ObCollationType collation_type,
@@ -2851,6 +2851,32 @@ static size_t ob_strnxfrm_uca_900(const ObCharsetInfo *cs, unsigned char *dst,
     }
   }
 }
+// The weights of UCA 9.0.0 collations are never 0 except the level separators, and
+// NO PAD collations compare trailing spaces as is, so the weight string terminated
+// with 0x0000 is a sortkey for memcmp() no matter is_memcmp or not.
+// is_valid_unicode is set to false if dst is too short to hold all the weights.
+static size_t ob_strnxfrm_uca_900_varlen(const ObCharsetInfo *cs, unsigned char *dst,
+                                         size_t dst_len, unsigned int nweights,
+                                         const unsigned char *src, size_t srclen,
+                                         bool is_memcmp __attribute__((unused)),
+                                         bool *is_valid_unicode) {
+  size_t res_len = 0;
+  if (dst_len < 4) {
+    *is_valid_unicode = false;
+  } else {
+    const size_t weights_len = (dst_len - 2) & ~static_cast<size_t>(1);
+    res_len = ob_strnxfrm_uca_900(cs, dst, weights_len, nweights, src, srclen, 0,
+                                  is_valid_unicode);
+    if (res_len >= weights_len) {
+      // the weights may be truncated
+      *is_valid_unicode = false;
+    }
+    dst[res_len] = 0x00;
+    dst[res_len + 1] = 0x00;
+    res_len += 2;
+  }
+  return res_len;
+}
 static size_t ob_strnxfrmlen_uca_900(const ObCharsetInfo *cs, size_t len) {
     // We really ought to have len % 4 == 0, but not all calling code conforms.
   const size_t num_codepoints = (len + 3) / 4;
@@ -2871,7 +2897,7 @@ ObCollationHandler ob_collation_any_uca_handler = {
 ObCollationHandler ob_collation_uca_900_handler = {
     ob_coll_init_uca,
     ob_coll_uninit_uca,   ob_strnncoll_uca_900,   ob_strnncollsp_uca_900,
-    ob_strnxfrm_uca_900,  ob_strnxfrmlen_uca_900, NULL, ob_like_range_mb,
+    ob_strnxfrm_uca_900,  ob_strnxfrmlen_uca_900, ob_strnxfrm_uca_900_varlen, ob_like_range_mb,
     ob_wildcmp_uca,       ob_strcasecmp_uca,      ob_instr_mb,
     ob_hash_sort_uca_900, ob_propagate_uca_900};
 
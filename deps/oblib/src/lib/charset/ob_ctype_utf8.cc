@@ -25,6 +25,11 @@
 #include "lib/charset/mb_wc.h"
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/charset/ob_ctype_utf8_tab.h"
+#include "common/ob_target_specific.h"
+
+#if OB_USE_MULTITARGET_CODE
+#include <immintrin.h>
+#endif
 
 #define IS_CONTINUATION_BYTE(code) (((code) >> 6) == 0x02)
 
@@ -98,22 +103,345 @@ static uint ob_mbcharlen_utf8mb4(const ObCharsetInfo *cs __attribute__((unused))
   return 0; /* Illegal mb head */;
 }
 
+namespace oceanbase
+{
+namespace common
+{
+/*
+  Error bits of the lookup tables used by utf8mb4_validate, see "Validating UTF-8 In Less
+  Than One Instruction Per Byte" (John Keiser, Daniel Lemire). Each table maps a nibble
+  (high or low nibble of the previous byte, high nibble of the current byte) to the errors
+  it may take part in, a pair of bytes is invalid if the three lookups share an error bit.
+
+  Surrogates (ED A0..ED BF) are accepted, which is the same as ob_valid_mbcharlen_utf8mb3.
+*/
+static const uint8_t UTF8_TOO_SHORT = 1 << 0;  // 11______ 0_______, 11______ 11______
+static const uint8_t UTF8_TOO_LONG = 1 << 1;   // 0_______ 10______
+static const uint8_t UTF8_OVERLONG_3 = 1 << 2; // 11100000 100_____
+static const uint8_t UTF8_TOO_LARGE = 1 << 3;  // 11110100 1001____, 11110100 101_____, 11110101+ 1001____ ...
+static const uint8_t UTF8_OVERLONG_2 = 1 << 5; // 1100000_ 10______
+static const uint8_t UTF8_TOO_LARGE_1000 = 1 << 6; // 11110101+ 1000____
+static const uint8_t UTF8_OVERLONG_4 = 1 << 6; // 11110000 1000____
+static const uint8_t UTF8_TWO_CONTS = 1 << 7;  // 10______ 10______
+static const uint8_t UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+static const uint8_t UTF8_BYTE_1_HIGH_TABLE[16] = {
+  // 0_______ ________
+  UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+  UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+  // 10______ ________
+  UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+  // 1100____ ________
+  UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+  // 1101____ ________
+  UTF8_TOO_SHORT,
+  // 1110____ ________
+  UTF8_TOO_SHORT | UTF8_OVERLONG_3,
+  // 1111____ ________
+  UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+};
+
+static const uint8_t UTF8_BYTE_1_LOW_TABLE[16] = {
+  // ____0000 ________
+  UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+  // ____0001 ________
+  UTF8_CARRY | UTF8_OVERLONG_2,
+  // ____001_ ________
+  UTF8_CARRY,
+  UTF8_CARRY,
+  // ____0100 ________
+  UTF8_CARRY | UTF8_TOO_LARGE,
+  // ____0101 ________ and above
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+};
+
+static const uint8_t UTF8_BYTE_2_HIGH_TABLE[16] = {
+  // ________ 0_______
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+  // ________ 1000____
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+  // ________ 1001____
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+  // ________ 101_____
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_TOO_LARGE,
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_TOO_LARGE,
+  // ________ 11______
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+};
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline static __m256i utf8_lookup16(const __m256i nibbles, const uint8_t *table)
+{
+  return _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(table))), nibbles);
+}
+
+inline static __m256i utf8_high_nibbles(const __m256i input)
+{
+  return _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F));
+}
+
+// the bytes of input shifted right by N, the first N bytes are taken from the end of prev_input
+template <int N>
+inline static __m256i utf8_prev(const __m256i input, const __m256i prev_input)
+{
+  return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+}
+
+// check one 32 bytes block, errors are accumulated into error
+inline static void utf8_check_block(const __m256i input,
+                                    const __m256i prev_input,
+                                    __m256i &prev_incomplete,
+                                    __m256i &error)
+{
+  if (0 == _mm256_movemask_epi8(input)) {
+    // an ascii block, the previous block must not end in the middle of a character
+    error = _mm256_or_si256(error, prev_incomplete);
+  } else {
+    const __m256i prev1 = utf8_prev<1>(input, prev_input);
+    const __m256i special_cases = _mm256_and_si256(
+        _mm256_and_si256(utf8_lookup16(utf8_high_nibbles(prev1), UTF8_BYTE_1_HIGH_TABLE),
+                         utf8_lookup16(_mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)), UTF8_BYTE_1_LOW_TABLE)),
+        utf8_lookup16(utf8_high_nibbles(input), UTF8_BYTE_2_HIGH_TABLE));
+    // the 3rd byte of 3/4 bytes characters and the 4th byte of 4 bytes characters must be
+    // continuation bytes, they are the only ones which are expected to have UTF8_TWO_CONTS
+    const __m256i is_third_byte = _mm256_subs_epu8(utf8_prev<2>(input, prev_input),
+                                                   _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+    const __m256i is_fourth_byte = _mm256_subs_epu8(utf8_prev<3>(input, prev_input),
+                                                    _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+    const __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                                                          _mm256_set1_epi8(static_cast<char>(0x80)));
+    error = _mm256_or_si256(error, _mm256_xor_si256(must_be_continuation, special_cases));
+    // a leading byte in the last 3 bytes may need bytes from the next block
+    const __m256i max_value = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1));
+    prev_incomplete = _mm256_subs_epu8(input, max_value);
+  }
+}
+
+// count the bytes which are not continuation bytes (10______), they are the leading bytes of
+// characters if the string is well formed
+inline static size_t utf8_count_chars(const __m256i input)
+{
+  return __builtin_popcount(static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpgt_epi8(input, _mm256_set1_epi8(static_cast<char>(0xBF))))));
+}
+
+// return whether [s, e) is well formed, and the number of characters if it is
+inline static bool utf8mb4_validate(const uchar *s, const uchar *e, size_t &char_cnt)
+{
+  __m256i error = _mm256_setzero_si256();
+  __m256i prev_input = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+  char_cnt = 0;
+  for (; s + 32 <= e && _mm256_testz_si256(error, error); s += 32) {
+    const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+    utf8_check_block(input, prev_input, prev_incomplete, error);
+    char_cnt += utf8_count_chars(input);
+    prev_input = input;
+  }
+  if (s < e && _mm256_testz_si256(error, error)) {
+    // the tail is padded with zero, which is taken as ascii characters
+    uchar buf[32] = {0};
+    memcpy(buf, s, e - s);
+    const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buf));
+    utf8_check_block(input, prev_input, prev_incomplete, error);
+    char_cnt += utf8_count_chars(input) - (32 - (e - s));
+  } else {
+    error = _mm256_or_si256(error, prev_incomplete);
+  }
+  return _mm256_testz_si256(error, error);
+}
+
+// return the first non-ascii byte in [s, e), or e if there is none
+inline static const uchar *utf8_skip_ascii(const uchar *s, const uchar *e)
+{
+  uint32_t mask = 0;
+  for (; s + 32 <= e && 0 == mask; s += 32) {
+    mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s))));
+  }
+  if (0 != mask) {
+    s = s - 32 + __builtin_ctz(mask);
+  } else {
+    while (s < e && *s < 0x80) {
+      ++s;
+    }
+  }
+  return s;
+}
+)
+
+OB_DECLARE_DEFAULT_CODE(
+inline static const uchar *utf8_skip_ascii(const uchar *s, const uchar *e)
+{
+  uint64_t mask = 0;
+  for (; s + 8 <= e && 0 == mask; s += 8) {
+    memcpy(&mask, s, 8);
+    mask &= 0x8080808080808080ULL;
+  }
+  if (0 != mask) {
+    s = s - 8 + (__builtin_ctzll(mask) >> 3);
+  } else {
+    while (s < e && *s < 0x80) {
+      ++s;
+    }
+  }
+  return s;
+}
+
+inline static bool utf8mb4_validate(const uchar *s, const uchar *e, size_t &char_cnt)
+{
+  bool is_valid = true;
+  char_cnt = 0;
+  while (is_valid && s < e) {
+    const uchar *ascii_end = utf8_skip_ascii(s, e);
+    char_cnt += ascii_end - s;
+    s = ascii_end;
+    if (s < e) {
+      const int mb_len = ob_valid_mbcharlen_utf8mb4(NULL, s, e);
+      if (mb_len <= 0) {
+        is_valid = false;
+      } else {
+        s += mb_len;
+        ++char_cnt;
+      }
+    }
+  }
+  return is_valid;
+}
+)
+} // end namespace common
+} // end namespace oceanbase
+
+static inline bool ob_utf8mb4_validate(const uchar *s, const uchar *e, size_t &char_cnt)
+{
+  bool is_valid = false;
+#if OB_USE_MULTITARGET_CODE
+  if (oceanbase::common::is_arch_supported(oceanbase::common::ObTargetArch::AVX2)) {
+    is_valid = oceanbase::common::specific::avx2::utf8mb4_validate(s, e, char_cnt);
+  } else {
+    is_valid = oceanbase::common::specific::normal::utf8mb4_validate(s, e, char_cnt);
+  }
+#else
+  is_valid = oceanbase::common::specific::normal::utf8mb4_validate(s, e, char_cnt);
+#endif
+  return is_valid;
+}
+
+static inline const uchar *ob_utf8_skip_ascii(const uchar *s, const uchar *e)
+{
+  const uchar *ret = NULL;
+#if OB_USE_MULTITARGET_CODE
+  if (oceanbase::common::is_arch_supported(oceanbase::common::ObTargetArch::AVX2)) {
+    ret = oceanbase::common::specific::avx2::utf8_skip_ascii(s, e);
+  } else {
+    ret = oceanbase::common::specific::normal::utf8_skip_ascii(s, e);
+  }
+#else
+  ret = oceanbase::common::specific::normal::utf8_skip_ascii(s, e);
+#endif
+  return ret;
+}
+
+/*
+  The same as ob_numchars_mb, ob_charpos_mb and ob_max_bytes_charpos_mb, but runs of ascii
+  characters are skipped by blocks, and well formed strings are validated and counted by
+  blocks. Ill-formed strings fall back to the character by character loop, so the results
+  are the same for them.
+*/
+static size_t ob_numchars_utf8mb4(const ObCharsetInfo *cs, const char *pos, const char *end)
+{
+  size_t count = 0;
+  if (!ob_utf8mb4_validate((const uchar *) pos, (const uchar *) end, count)) {
+    count = ob_numchars_mb(cs, pos, end);
+  }
+  return count;
+}
+
+static size_t ob_charpos_utf8mb4(const ObCharsetInfo *cs, const char *pos, const char *end, size_t length)
+{
+  const char *start= pos;
+  while (length && pos < end) {
+    if ((uchar) *pos < 0x80) {
+      const char *ascii_end = pos + OB_MIN((size_t) (end - pos), length);
+      ascii_end = (const char *) ob_utf8_skip_ascii((const uchar *) pos, (const uchar *) ascii_end);
+      length -= ascii_end - pos;
+      pos = ascii_end;
+    } else {
+      unsigned int mb_len;
+      pos+= (mb_len= ob_ismbchar_utf8mb4(cs, pos, end)) ? mb_len : 1;
+      length--;
+    }
+  }
+  return (size_t) (length ? end+2-start : pos-start);
+}
+
+static size_t ob_max_bytes_charpos_utf8mb4(const ObCharsetInfo *cs, const char *pos, const char *end,
+                                           size_t max_bytes, size_t *char_len)
+{
+  const char *start= pos;
+  bool is_full = false;
+  while (!is_full && max_bytes && pos < end) {
+    if ((uchar) *pos < 0x80) {
+      const char *ascii_end = pos + OB_MIN((size_t) (end - pos), max_bytes);
+      ascii_end = (const char *) ob_utf8_skip_ascii((const uchar *) pos, (const uchar *) ascii_end);
+      max_bytes -= ascii_end - pos;
+      *char_len += ascii_end - pos;
+      pos = ascii_end;
+    } else {
+      unsigned int mb_len = ob_ismbchar_utf8mb4(cs, pos, end);
+      unsigned int bytes = mb_len ? mb_len : 1;
+      if (max_bytes < bytes) {
+        is_full = true;
+      } else {
+        pos += bytes;
+        max_bytes -= bytes;
+        ++*char_len;
+      }
+    }
+  }
+  return (size_t) (pos-start);
+}
+
 static inline size_t ob_well_formed_len_utf8mb4(const ObCharsetInfo *cs,
                                          const char *b, const char *e,
                                          size_t pos, int *error)
 {
   const char *b_start= b;
+  size_t char_cnt= 0;
   *error= 0;
-  while (pos)
+  // callers checking a few characters of a long string take the loop below, it stops at pos
+  if (pos >= (size_t) (e - b) &&
+      ob_utf8mb4_validate((const uchar *) b, (const uchar *) e, char_cnt))
   {
-    int mb_len;
-    if ((mb_len= ob_valid_mbcharlen_utf8mb4(cs, (uchar*) b, (uchar*) e)) <= 0)
+    b= e;
+  }
+  else
+  {
+    while (pos)
     {
-      *error= b < e ? 1 : 0;
-      break;
+      int mb_len;
+      if ((mb_len= ob_valid_mbcharlen_utf8mb4(cs, (uchar*) b, (uchar*) e)) <= 0)
+      {
+        *error= b < e ? 1 : 0;
+        break;
+      }
+      b+= mb_len;
+      pos--;
     }
-    b+= mb_len;
-    pos--;
   }
   return (size_t) (b - b_start);
 }
@@ -951,9 +1279,9 @@ ObCharsetHandler ob_charset_utf8mb4_handler=
   NULL,
   ob_ismbchar_utf8mb4,
   ob_mbcharlen_utf8mb4,
-  ob_numchars_mb,
-  ob_charpos_mb,
-  ob_max_bytes_charpos_mb,
+  ob_numchars_utf8mb4,
+  ob_charpos_utf8mb4,
+  ob_max_bytes_charpos_utf8mb4,
   ob_well_formed_len_utf8mb4,
   ob_lengthsp_8bit,
   ob_mb_wc_utf8mb4_thunk,
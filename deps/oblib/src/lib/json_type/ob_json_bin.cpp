@@ -611,6 +611,164 @@ int ObJsonBinSerializer::serialize_json_array(ObJsonArray *array, ObJsonBuffer &
   return ret;
 }
 
+bool ObJsonBinSerializer::is_inlined_value(const ObJsonBinPendingValue &value, const uint8_t entry_var_type)
+{
+  bool is_inlined = false;
+  switch (value.type_) {
+    case ObJsonNodeType::J_NULL:
+    case ObJsonNodeType::J_BOOLEAN: {
+      is_inlined = true;
+      break;
+    }
+    case ObJsonNodeType::J_INT: {
+      is_inlined = ObJsonVar::get_var_type(value.int_val_) <= entry_var_type;
+      break;
+    }
+    case ObJsonNodeType::J_UINT: {
+      is_inlined = ObJsonVar::get_var_type(static_cast<uint64_t>(value.int_val_)) <= entry_var_type;
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+  return is_inlined;
+}
+
+uint64_t ObJsonBinSerializer::calc_container_size(const bool is_object,
+                                                  const ObJsonBinPendingValue *values,
+                                                  const int64_t count,
+                                                  const uint8_t entry_var_type)
+{
+  const uint64_t entry_size = ObJsonVar::get_var_size(entry_var_type);
+  uint64_t size = OB_JSON_BIN_OBJ_HEADER_LEN
+      + ObJsonVar::get_var_size(ObJsonVar::get_var_type(static_cast<uint64_t>(count)))
+      + entry_size // obj size
+      + count * (entry_size + OB_JSON_BIN_VALUE_TYPE_LEN);
+  if (is_object) {
+    size += count * entry_size * 2;
+  }
+  for (int64_t i = 0; i < count; i++) {
+    if (is_object) {
+      size += values[i].key_.length();
+    }
+    if (!is_inlined_value(values[i], entry_var_type)) {
+      size += values[i].len_;
+    }
+  }
+  return size;
+}
+
+int ObJsonBinSerializer::serialize_json_container(const bool is_object,
+                                                  const ObJsonBinPendingValue *values,
+                                                  const int64_t count,
+                                                  const char *value_data,
+                                                  ObJsonBuffer &result)
+{
+  INIT_SUCC(ret);
+  const int64_t start_pos = result.length();
+  ObJsonBin container_bin;
+  ObJsonBinMeta meta;
+  // The size of every member is known already, so choose the smallest entry var type that can
+  // hold the whole container rather than estimating and re-serializing like serialize_json_object.
+  uint8_t entry_var_type = JBLS_UINT8;
+  uint64_t container_size = calc_container_size(is_object, values, count, entry_var_type);
+  while (entry_var_type < JBLS_UINT64 && ObJsonVar::get_var_type(container_size) > entry_var_type) {
+    entry_var_type++;
+    container_size = calc_container_size(is_object, values, count, entry_var_type);
+  }
+  meta.set_type(is_object ? ObJsonBin::get_object_vertype() : ObJsonBin::get_array_vertype(), false);
+  meta.set_element_count(count);
+  meta.set_element_count_var_type(ObJsonVar::get_var_type(static_cast<uint64_t>(count)));
+  meta.set_obj_size(container_size);
+  meta.set_obj_size_var_type(entry_var_type);
+  meta.set_entry_var_type(entry_var_type);
+  meta.set_is_continuous(true);
+  meta.calc_entry_array();
+
+  if (OB_ISNULL(values) && count > 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("values is null", K(ret), K(count));
+  } else if (OB_FAIL(result.reserve(container_size))) {
+    LOG_WARN("reserve buffer fail", K(ret), K(container_size));
+  } else if (OB_FAIL(meta.to_header(result))) {
+    LOG_WARN("to obj header fail", K(ret));
+  } else if (OB_FAIL(container_bin.reset(result.string(), start_pos, nullptr))) {
+    LOG_WARN("init bin with meta fail", K(ret), K(meta));
+  }
+
+  for (int64_t i = 0; OB_SUCC(ret) && is_object && i < count; i++) {
+    const ObString &key = values[i].key_;
+    uint64_t key_offset = result.length() - start_pos;
+    if (OB_FAIL(container_bin.set_key_entry(i, key_offset, key.length(), false))) {
+      LOG_WARN("set_key_entry fail", K(ret), K(key));
+    } else if (OB_FAIL(result.append(key))) {
+      LOG_WARN("append key fail", K(ret), K(key));
+    } else if (OB_FALSE_IT(container_bin.set_current(result.string(), start_pos))) {
+    }
+  }
+
+  for (int64_t i = 0; OB_SUCC(ret) && i < count; i++) {
+    const ObJsonBinPendingValue &value = values[i];
+    if (is_inlined_value(value, entry_var_type)) {
+      uint64_t inlined_val = 0;
+      uint8_t inlined_type = 0;
+      if (ObJsonNodeType::J_NULL == value.type_) {
+        inlined_type = static_cast<uint8_t>(ObJsonBin::get_null_vertype());
+      } else if (ObJsonNodeType::J_BOOLEAN == value.type_) {
+        inlined_val = static_cast<uint64_t>(value.int_val_);
+        inlined_type = static_cast<uint8_t>(ObJsonBin::get_boolean_vertype());
+      } else if (ObJsonNodeType::J_INT == value.type_) {
+        inlined_val = ObJsonVar::var_int2uint(value.int_val_);
+        inlined_type = static_cast<uint8_t>(ObJsonBin::get_int_vertype());
+      } else {
+        inlined_val = static_cast<uint64_t>(value.int_val_);
+        inlined_type = static_cast<uint8_t>(ObJsonBin::get_uint_vertype());
+      }
+      if (OB_FAIL(container_bin.set_value_entry(i, inlined_val, inlined_type | OB_JSON_TYPE_INLINE_MASK, false))) {
+        LOG_WARN("set_value_entry for inline fail", K(ret), K(value));
+      }
+    } else {
+      uint64_t value_offset = result.length() - start_pos;
+      uint8_t value_type = ObJsonVerType::get_json_vertype(value.type_);
+      if (OB_FAIL(container_bin.set_value_entry(i, value_offset, value_type, false))) {
+        LOG_WARN("set_value_entry fail", K(ret), K(value_offset), K(value_type));
+      } else if (OB_FAIL(result.append(value_data + value.offset_, value.len_))) {
+        LOG_WARN("append value fail", K(ret), K(value));
+      } else if (OB_FALSE_IT(container_bin.set_current(result.string(), start_pos))) {
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    uint64_t real_size = static_cast<uint64_t>(result.length() - start_pos);
+    if (real_size != container_size) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("container size mismatch", K(ret), K(real_size), K(container_size), K(count));
+    } else if (OB_FAIL(container_bin.set_obj_size(real_size))) {
+      LOG_WARN("set_obj_size fail", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObJsonBinSerializer::serialize_json_doc_container(const bool is_object,
+                                                      const ObJsonBinPendingValue *values,
+                                                      const int64_t count,
+                                                      const char *value_data,
+                                                      ObJsonBuffer &result)
+{
+  INIT_SUCC(ret);
+  if (OB_FAIL(ObJsonBin::add_doc_header_v0(result))) {
+    LOG_WARN("add_doc_header_v0 fail", K(ret));
+  } else if (OB_FAIL(serialize_json_container(is_object, values, count, value_data, result))) {
+    LOG_WARN("serialize json container fail", K(ret), K(is_object), K(count));
+  } else if (OB_FAIL(ObJsonBin::set_doc_header_v0(result, result.length()))) {
+    LOG_WARN("set_doc_header_v0 fail", K(ret));
+  }
+  return ret;
+}
+
 int ObJsonBinSerializer::serialize_json_integer(int64_t value, ObJsonBuffer &result)
 {
   INIT_SUCC(ret);
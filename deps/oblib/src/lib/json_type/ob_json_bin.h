@@ -1112,6 +1112,22 @@ public:
 };
 
 
+// A member of an object or array that has been parsed from json text but not yet been written
+// into the binary of its parent, see ObJsonBinSerializer::serialize_json_container.
+struct ObJsonBinPendingValue
+{
+  ObJsonBinPendingValue()
+    : key_(), type_(ObJsonNodeType::J_ERROR), int_val_(0), offset_(0), len_(0)
+  {}
+  TO_STRING_KV(K_(key), K_(type), K_(int_val), K_(offset), K_(len));
+
+  ObString key_;          // empty for array elements
+  ObJsonNodeType type_;
+  int64_t int_val_;       // value of null, boolean, int and uint, used to decide inlining
+  int64_t offset_;        // offset of the serialized value in the value data
+  int64_t len_;           // length of the serialized value
+};
+
 class ObJsonBinSerializer
 {
 public:
@@ -1123,11 +1139,31 @@ public:
   int serialize_json_object(ObJsonObject* object, ObJsonBuffer &result, uint32_t depth = 0);
   int serialize_json_array(ObJsonArray *array, ObJsonBuffer &result, uint32_t depth = 0);
   int serialize_json_value(ObJsonNode *json_tree, ObJsonBuffer &result);
+  // Serialize an object or array whose members have been serialized into value_data already.
+  // Members of an object should be sorted by ObJsonKeyCompare and be unique.
+  int serialize_json_container(const bool is_object,
+                               const ObJsonBinPendingValue *values,
+                               const int64_t count,
+                               const char *value_data,
+                               ObJsonBuffer &result);
+  // Same as serialize_json_container, but for the root container with the document header.
+  int serialize_json_doc_container(const bool is_object,
+                                   const ObJsonBinPendingValue *values,
+                                   const int64_t count,
+                                   const char *value_data,
+                                   ObJsonBuffer &result);
 
 public:
   static int serialize_json_integer(int64_t value, ObJsonBuffer &result);
   static int serialize_json_decimal(ObJsonDecimal *json_dec, ObJsonBuffer &result);
 
+private:
+  static bool is_inlined_value(const ObJsonBinPendingValue &value, const uint8_t entry_var_type);
+  static uint64_t calc_container_size(const bool is_object,
+                                      const ObJsonBinPendingValue *values,
+                                      const int64_t count,
+                                      const uint8_t entry_var_type);
+
 private:
   ObIAllocator *allocator_;
   ObJsonBinCtx bin_ctx_;
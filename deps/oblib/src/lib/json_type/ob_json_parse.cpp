@@ -13,6 +13,7 @@
 
 #define USING_LOG_PREFIX SQL
 #include "ob_json_parse.h"
+#include <algorithm>
 #include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
@@ -138,6 +139,62 @@ int ObJsonParser::parse_json_text(ObIAllocator *allocator,
   return ret;
 }
 
+int ObJsonParser::get_bin(ObIAllocator *allocator, const ObString &text, ObString &j_bin,
+                          uint32_t parse_flag, uint32_t max_depth_config)
+{
+  INIT_SUCC(ret);
+  char *buf = NULL;
+  const uint64_t length = text.length();
+  if (OB_ISNULL(allocator) || OB_ISNULL(text.ptr()) || length == 0) {
+    ret = OB_ERR_NULL_VALUE;
+    LOG_WARN("param is null or json text length is 0", KP(allocator), K(length));
+  } else if (HAS_FLAG(parse_flag, JSN_SCHEMA_FLAG) || HAS_FLAG(parse_flag, JSN_PRESERVE_DUP_FLAG)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("parse flag not supported", K(ret), K(parse_flag));
+  } else if (OB_ISNULL(buf = reinterpret_cast<char *>(allocator->alloc(length + 1)))) { // for '\0'
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory for json text", K(ret), K(length));
+  } else {
+    MEMCPY(buf, text.ptr(), length);
+    buf[length] = '\0';
+    ObJsonBinDirectHandler handler(allocator, HAS_FLAG(parse_flag, JSN_UNIQUE_FLAG), max_depth_config);
+    ObRapidJsonAllocator parse_allocator(allocator);
+    rapidjson::InsituStringStream ss(static_cast<char *>(buf));
+    ObRapidJsonReader reader(&parse_allocator);
+    rapidjson::ParseResult r;
+    try {
+      if (HAS_FLAG(parse_flag, JSN_RELAXED_FLAG)) {
+        r = reader.Parse<RELAXJSON_FLAG>(ss, handler);
+      } else if (HAS_FLAG(parse_flag, JSN_STRICT_FLAG)) {
+        r = reader.Parse<STRICTJSON_FLAG>(ss, handler);
+      } else {
+        r = reader.Parse<rapidjson::kParseInsituFlag>(ss, handler);
+      }
+    } catch (const std::bad_alloc &e) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory for json text", K(ret), K(length));
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (!r.IsError()) {
+      if (OB_FAIL(handler.get_built_bin(j_bin))) {
+        LOG_WARN("fail to get json binary", K(ret));
+      }
+    } else {
+      allocator->free(buf);
+      if (handler.has_duplicate_key()) {
+        ret = OB_ERR_DUPLICATE_KEY;
+      } else if (OB_FAIL(handler.get_error_code())) {
+      } else {
+        ret = OB_ERR_INVALID_JSON_TEXT;
+      }
+      LOG_WARN("fail to parse json text", K(ret), K(r.Code()), "offset", reader.GetErrorOffset());
+    }
+  }
+
+  return ret;
+}
+
 int ObJsonParser::check_json_syntax(const ObString &j_doc, ObIAllocator *allocator,
                                     uint32_t parse_flag, uint32_t max_depth_config)
 {
@@ -593,6 +650,294 @@ bool ObRapidJsonHandler::Key(const char *str, rapidjson::SizeType length, bool c
   return is_continue;
 }
 
+bool ObJsonBinDirectHandler::handle_ret(const int ret)
+{
+  if (OB_ERR_DUPLICATE_KEY == ret) {
+    with_duplicate_key_ = true;
+  } else if (OB_ERR_JSON_OUT_OF_DEPTH == ret || OB_INVALID_NUMERIC == ret) {
+    // reported as invalid json text, the same as ObRapidJsonHandler
+  } else if (OB_SUCCESS != ret) {
+    err_code_ = ret;
+  }
+  return OB_SUCCESS == ret;
+}
+
+int ObJsonBinDirectHandler::seeing_value(const ObJsonNodeType type,
+                                         const int64_t int_val,
+                                         const int64_t value_buf_pos)
+{
+  INIT_SUCC(ret);
+  ObJsonBinPendingValue value;
+  value.type_ = type;
+  value.int_val_ = int_val;
+  value.offset_ = value_buf_pos;
+  value.len_ = value_buf_.length() - value_buf_pos;
+  if (is_in_object()) {
+    value.key_ = key_;
+  }
+  if (OB_FAIL(values_.push_back(value))) {
+    LOG_WARN("fail to push back value", K(ret), K(value));
+  }
+  return ret;
+}
+
+int ObJsonBinDirectHandler::seeing_integer(const ObJsonNodeType type, const int64_t value)
+{
+  INIT_SUCC(ret);
+  const int64_t pos = value_buf_.length();
+  if (OB_FAIL(ObJsonBinSerializer::serialize_json_integer(value, value_buf_))) {
+    LOG_WARN("fail to serialize json integer", K(ret), K(value));
+  } else if (OB_FAIL(seeing_value(type, value, pos))) {
+    LOG_WARN("fail to add json integer", K(ret), K(value));
+  }
+  return ret;
+}
+
+int ObJsonBinDirectHandler::start_container(const bool is_object)
+{
+  INIT_SUCC(ret);
+  if (frames_.count() > config_json_max_depth_) {
+    ret = OB_ERR_JSON_OUT_OF_DEPTH;
+    LOG_WARN("current json doc is over depth", K(ret), K(frames_.count()));
+  } else if (OB_FAIL(frames_.push_back(Frame(is_object, is_in_object() ? key_ : ObString(),
+                                             values_.count(), value_buf_.length())))) {
+    LOG_WARN("fail to push back frame", K(ret));
+  }
+  return ret;
+}
+
+// Keep the last one of the members with the same key, the same as ObJsonObject::unique.
+void ObJsonBinDirectHandler::unique_members(ObJsonBinPendingValue *values, int64_t &count)
+{
+  int64_t cur = 0;
+  for (int64_t pos = 1; pos < count; pos++) {
+    if (values[cur].key_ == values[pos].key_) {
+      values[cur] = values[pos];
+    } else if (++cur != pos) {
+      values[cur] = values[pos];
+    }
+  }
+  count = count > 0 ? cur + 1 : 0;
+}
+
+int ObJsonBinDirectHandler::end_container(const bool is_object)
+{
+  INIT_SUCC(ret);
+  Frame frame;
+  if (frames_.count() <= 0 || frames_.at(frames_.count() - 1).is_object_ != is_object) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected end of container", K(ret), K(is_object), K(frames_));
+  } else if (OB_FAIL(frames_.pop_back(frame))) {
+    LOG_WARN("fail to pop frame", K(ret));
+  } else {
+    const bool is_root = frames_.count() == 0;
+    const int64_t origin_count = values_.count() - frame.value_idx_;
+    int64_t count = origin_count;
+    ObJsonBinPendingValue *members = count > 0 ? &values_.at(frame.value_idx_) : NULL;
+    ObJsonBuffer &container_buf = is_root ? result_ : container_buf_;
+    container_buf.reuse();
+    if (is_object && count > 1) {
+      std::stable_sort(members, members + count, KeyCompare());
+      unique_members(members, count);
+    }
+    if (with_unique_key_ && count < origin_count) {
+      ret = OB_ERR_DUPLICATE_KEY;
+      LOG_WARN("found duplicate key", K(ret), K(count), K(origin_count));
+    } else if (is_root && OB_FAIL(serializer_.serialize_json_doc_container(is_object, members, count,
+                                                                          value_buf_.ptr(), container_buf))) {
+      LOG_WARN("fail to serialize json document", K(ret), K(is_object), K(count));
+    } else if (!is_root && OB_FAIL(serializer_.serialize_json_container(is_object, members, count,
+                                                                        value_buf_.ptr(), container_buf))) {
+      LOG_WARN("fail to serialize json container", K(ret), K(is_object), K(count));
+    } else {
+      // replace the members with the container
+      while (values_.count() > frame.value_idx_) {
+        values_.pop_back();
+      }
+      if (OB_FAIL(value_buf_.set_length(frame.value_buf_pos_))) {
+        LOG_WARN("fail to truncate value buf", K(ret), K(frame));
+      } else if (is_root) {
+      } else if (OB_FAIL(value_buf_.append(container_buf.ptr(), container_buf.length()))) {
+        LOG_WARN("fail to append container", K(ret), K(frame));
+      } else {
+        key_ = frame.key_;
+        if (OB_FAIL(seeing_value(is_object ? ObJsonNodeType::J_OBJECT : ObJsonNodeType::J_ARRAY,
+                                 0, frame.value_buf_pos_))) {
+          LOG_WARN("fail to add container", K(ret), K(frame));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObJsonBinDirectHandler::get_built_bin(ObString &j_bin)
+{
+  INIT_SUCC(ret);
+  if (frames_.count() != 0) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("json document is not complete", K(ret), K(frames_));
+  } else if (result_.length() > 0) {
+    // root is object or array
+    ret = result_.get_result_string(j_bin);
+  } else if (values_.count() != 1) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected count of root value", K(ret), K(values_.count()));
+  } else {
+    // for scalar root, need add type byte except string type, the same as ObJsonBinSerializer
+    const ObJsonBinPendingValue &value = values_.at(0);
+    ObJBVerType vertype = ObJsonVerType::get_json_vertype(value.type_);
+    if (!ObJsonVerType::is_opaque_or_string(vertype)
+        && OB_FAIL(result_.append(reinterpret_cast<const char*>(&vertype), sizeof(uint8_t)))) {
+      LOG_WARN("fail to append type", K(ret), K(value));
+    } else if (OB_FAIL(result_.append(value_buf_.ptr() + value.offset_, value.len_))) {
+      LOG_WARN("fail to append value", K(ret), K(value));
+    } else {
+      ret = result_.get_result_string(j_bin);
+    }
+  }
+  return ret;
+}
+
+bool ObJsonBinDirectHandler::Null()
+{
+  INIT_SUCC(ret);
+  const int64_t pos = value_buf_.length();
+  if (OB_FAIL(value_buf_.append("\0", sizeof(char)))) {
+    LOG_WARN("fail to append null", K(ret));
+  } else if (OB_FAIL(seeing_value(ObJsonNodeType::J_NULL, 0, pos))) {
+    LOG_WARN("fail to add null", K(ret));
+  }
+  return handle_ret(ret);
+}
+
+bool ObJsonBinDirectHandler::Bool(bool value)
+{
+  INIT_SUCC(ret);
+  const int64_t pos = value_buf_.length();
+  char c = static_cast<char>(value);
+  if (OB_FAIL(value_buf_.append(&c, sizeof(char)))) {
+    LOG_WARN("fail to append boolean", K(ret));
+  } else if (OB_FAIL(seeing_value(ObJsonNodeType::J_BOOLEAN, value, pos))) {
+    LOG_WARN("fail to add boolean", K(ret));
+  }
+  return handle_ret(ret);
+}
+
+bool ObJsonBinDirectHandler::Int(int value)
+{
+  return handle_ret(seeing_integer(ObJsonNodeType::J_INT, value));
+}
+
+bool ObJsonBinDirectHandler::Uint(unsigned value)
+{
+  // adapt mysql, use J_INT, the same as ObRapidJsonHandler
+  return handle_ret(seeing_integer(ObJsonNodeType::J_INT, value));
+}
+
+bool ObJsonBinDirectHandler::Int64(int64_t value)
+{
+  return handle_ret(seeing_integer(ObJsonNodeType::J_INT, value));
+}
+
+bool ObJsonBinDirectHandler::Uint64(uint64_t value)
+{
+  return handle_ret(seeing_integer(ObJsonNodeType::J_UINT, static_cast<int64_t>(value)));
+}
+
+bool ObJsonBinDirectHandler::Double(double value)
+{
+  INIT_SUCC(ret);
+  const int64_t pos = value_buf_.length();
+  if (!std::isfinite(value)) {
+    ret = OB_INVALID_NUMERIC;
+    LOG_WARN("value is not finite", K(ret), K(value));
+  } else if (OB_FAIL(value_buf_.append(reinterpret_cast<const char*>(&value), sizeof(double)))) {
+    LOG_WARN("fail to append double", K(ret));
+  } else if (OB_FAIL(seeing_value(ObJsonNodeType::J_DOUBLE, 0, pos))) {
+    LOG_WARN("fail to add double", K(ret));
+  }
+  return handle_ret(ret);
+}
+
+// Never called, since we don't instantiate the parser with kParseNumbersAsStringsFlag.
+bool ObJsonBinDirectHandler::RawNumber(const char *, rapidjson::SizeType, bool copy)
+{
+  UNUSED(copy);
+  return false;
+}
+
+// [type][length][string], the string is copied into value_buf_, so no need to deep copy it
+bool ObJsonBinDirectHandler::String(const char *str, rapidjson::SizeType length, bool copy)
+{
+  UNUSED(copy);
+  INIT_SUCC(ret);
+  const int64_t pos = value_buf_.length();
+  const int64_t ser_len = serialization::encoded_length_vi64(length);
+  int64_t len_pos = pos + sizeof(uint8_t);
+  ObJBVerType vertype = ObJsonVerType::get_json_vertype(ObJsonNodeType::J_STRING);
+  if (OB_FAIL(value_buf_.append(reinterpret_cast<const char*>(&vertype), sizeof(uint8_t)))) {
+    LOG_WARN("fail to append string type", K(ret));
+  } else if (OB_FAIL(value_buf_.reserve(ser_len + length))) {
+    LOG_WARN("fail to reserve string", K(ret), K(ser_len), K(length));
+  } else if (OB_FAIL(serialization::encode_vi64(value_buf_.ptr(), value_buf_.capacity(), len_pos, length))) {
+    LOG_WARN("fail to serialize string length", K(ret), K(length));
+  } else if (OB_FAIL(value_buf_.set_length(len_pos))) {
+    LOG_WARN("fail to set length", K(ret), K(len_pos));
+  } else if (length > 0 && OB_FAIL(value_buf_.append(str, length))) {
+    LOG_WARN("fail to append string", K(ret), K(length));
+  } else if (OB_FAIL(seeing_value(ObJsonNodeType::J_STRING, 0, pos))) {
+    LOG_WARN("fail to add string", K(ret));
+  }
+  return handle_ret(ret);
+}
+
+bool ObJsonBinDirectHandler::StartObject()
+{
+  return handle_ret(start_container(true));
+}
+
+bool ObJsonBinDirectHandler::EndObject(rapidjson::SizeType length)
+{
+  UNUSED(length);
+  return handle_ret(end_container(true));
+}
+
+bool ObJsonBinDirectHandler::StartArray()
+{
+  return handle_ret(start_container(false));
+}
+
+bool ObJsonBinDirectHandler::EndArray(rapidjson::SizeType length)
+{
+  UNUSED(length);
+  return handle_ret(end_container(false));
+}
+
+bool ObJsonBinDirectHandler::Key(const char *str, rapidjson::SizeType length, bool copy)
+{
+  INIT_SUCC(ret);
+  if (!is_in_object()) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected json key", K(ret));
+  } else if (copy && length > 0) {
+    // need deep-copy, the buffer of rapidjson will be reused
+    char *dst_buf = NULL;
+    if (OB_ISNULL(dst_buf = static_cast<char *>(allocator_->alloc(length)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory fail", K(ret), K(length));
+    } else {
+      MEMCPY(dst_buf, str, length);
+      key_.assign_ptr(dst_buf, length);
+    }
+  } else if (length > 0) {
+    key_.assign_ptr(str, length);
+  } else {
+    key_ = ObString();
+  }
+  return handle_ret(ret);
+}
+
 #undef TEST_RELAXJSON_FLAG
 
 } // namespace common
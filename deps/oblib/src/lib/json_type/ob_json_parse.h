@@ -15,6 +15,8 @@
 #define OCEANBASE_SQL_OB_JSON_PARSE
 
 #include "ob_json_tree.h"
+#include "ob_json_bin.h"
+#include "lib/container/ob_se_array.h"
 #include <rapidjson/error/en.h>
 #include <rapidjson/error/error.h>
 #include <rapidjson/memorystream.h>
@@ -64,6 +66,20 @@ public:
                              uint32_t max_depth_config = JSON_DOCUMENT_MAX_DEPTH);
 
   
+  // Parse json text to json binary directly, without building an ObJsonNode tree.
+  // The result holds the same json value as ObJsonBinSerializer::serialize() on the tree returned
+  // by get_tree, but the bytes may differ: the var type of entries is chosen from the real size
+  // here while the serializer uses its estimated size, so do not compare or checksum the binaries.
+  // JSN_SCHEMA_FLAG and JSN_PRESERVE_DUP_FLAG are not supported.
+  //
+  // @param [in]  allocator   Alloc memory for json text and json binary.
+  // @param [in]  text        The json documemt which need to parse.
+  // @param [out] j_bin       The raw json binary after successful parsing.
+  // @return Returns OB_SUCCESS on success, error code otherwise.
+  static int get_bin(ObIAllocator *allocator, const ObString &text,
+                     ObString &j_bin, uint32_t parse_flag = 0,
+                     uint32_t max_depth_config = JSON_DOCUMENT_MAX_DEPTH);
+
   // Check json document syntax.(for json_valid)
   //
   // @param [in] j_doc The json documemt which need to check.
@@ -200,6 +216,97 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObRapidJsonHandler);
 };
 
+// Build json binary from the SAX events of rapidjson without ObJsonNode tree.
+// Scalars are serialized into value_buf_ as soon as they are seen, and members of each open
+// container are kept in values_. When a container ends, its members are sorted, deduplicated and
+// serialized into a container binary, which replaces them in value_buf_ and values_ as a single
+// member of the parent container.
+class ObJsonBinDirectHandler final : public rapidjson::BaseReaderHandler<>
+{
+public:
+  explicit ObJsonBinDirectHandler(ObIAllocator *allocator, bool with_unique_key = false,
+                                  uint32_t json_depth_config = JSON_DOCUMENT_MAX_DEPTH)
+      : allocator_(allocator),
+        serializer_(allocator),
+        value_buf_(allocator),
+        container_buf_(allocator),
+        result_(allocator),
+        values_(),
+        frames_(),
+        key_(),
+        err_code_(OB_SUCCESS),
+        with_unique_key_(with_unique_key),
+        with_duplicate_key_(false),
+        config_json_max_depth_(json_depth_config < JSON_DOCUMENT_MAX_DEPTH ? JSON_DOCUMENT_MAX_DEPTH : json_depth_config)
+  {
+  }
+  virtual ~ObJsonBinDirectHandler() {}
+
+  bool Null();
+  bool Bool(bool value);
+  bool Int(int value);
+  bool Uint(unsigned value);
+  bool Int64(int64_t value);
+  bool Uint64(uint64_t value);
+  bool Double(double value);
+  bool RawNumber(const char *, rapidjson::SizeType, bool copy);
+  bool String(const char *str, rapidjson::SizeType length, bool copy);
+  bool StartObject();
+  bool EndObject(rapidjson::SizeType length);
+  bool StartArray();
+  bool EndArray(rapidjson::SizeType length);
+  bool Key(const char *str, rapidjson::SizeType length, bool copy);
+  bool has_duplicate_key() const { return with_duplicate_key_; }
+  int get_error_code() const { return err_code_; }
+  // get the json binary after the whole document has been parsed.
+  int get_built_bin(ObString &j_bin);
+
+private:
+  struct Frame
+  {
+    Frame() : is_object_(false), key_(), value_idx_(0), value_buf_pos_(0) {}
+    Frame(const bool is_object, const ObString &key, const int64_t value_idx, const int64_t value_buf_pos)
+      : is_object_(is_object), key_(key), value_idx_(value_idx), value_buf_pos_(value_buf_pos) {}
+    TO_STRING_KV(K_(is_object), K_(key), K_(value_idx), K_(value_buf_pos));
+    bool is_object_;
+    ObString key_;           // the key of the container in its parent object
+    int64_t value_idx_;      // the first member in values_
+    int64_t value_buf_pos_;  // the first byte of members in value_buf_
+  };
+  struct KeyCompare
+  {
+    bool operator()(const ObJsonBinPendingValue &left, const ObJsonBinPendingValue &right) const
+    {
+      return left.key_.length() != right.key_.length()
+          ? left.key_.length() < right.key_.length()
+          : left.key_.compare(right.key_) < 0;
+    }
+  };
+
+  bool is_in_object() const { return frames_.count() > 0 && frames_.at(frames_.count() - 1).is_object_; }
+  bool handle_ret(const int ret);
+  int seeing_value(const ObJsonNodeType type, const int64_t int_val, const int64_t value_buf_pos);
+  int seeing_integer(const ObJsonNodeType type, const int64_t value);
+  int start_container(const bool is_object);
+  int end_container(const bool is_object);
+  static void unique_members(ObJsonBinPendingValue *values, int64_t &count);
+
+private:
+  ObIAllocator *allocator_;
+  ObJsonBinSerializer serializer_;
+  ObJsonBuffer value_buf_;      // serialized members of all open containers
+  ObJsonBuffer container_buf_;  // serialized container that has just ended
+  ObJsonBuffer result_;         // serialized json document
+  ObSEArray<ObJsonBinPendingValue, 32> values_;
+  ObSEArray<Frame, 8> frames_;
+  ObString key_;
+  int err_code_;
+  bool with_unique_key_;
+  bool with_duplicate_key_;
+  uint32_t config_json_max_depth_;
+  DISALLOW_COPY_AND_ASSIGN(ObJsonBinDirectHandler);
+};
+
 // for json_valid
 class ObJsonSyntaxCheckHandler final : public rapidjson::BaseReaderHandler<>
 {
@@ -118,6 +118,31 @@ int ObRoaringBitmap::value_add(uint64_t value)
   return ret;
 }
 
+int ObRoaringBitmap::value_add_batch(const uint64_t *values, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(values) || OB_UNLIKELY(count < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(values), K(count));
+  } else if (!is_bitmap_type() && count > MAX_BITMAP_SET_VALUES) {
+    // large batches go to croaring directly, optimize() shrinks small results back before serialization
+    if (OB_FAIL(convert_to_bitmap())) {
+      LOG_WARN("failed to convert roaringbitmap to bitmap type", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (is_bitmap_type()) {
+    ROARING_TRY_CATCH(roaring::api::roaring64_bitmap_add_many(bitmap_, count, values));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; i++) {
+      if (OB_FAIL(value_add(values[i]))) {
+        LOG_WARN("failed to add value", K(ret), K(i), K(values[i]));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObRoaringBitmap::value_remove(uint64_t value) {
   int ret = OB_SUCCESS;
   switch (type_) {
@@ -100,6 +100,8 @@ public:
   bool is_contains(uint64_t value);
 
   int value_add(uint64_t value);
+  // add values in bulk, the whole batch goes to croaring once the bitmap is in bitmap type
+  int value_add_batch(const uint64_t *values, const int64_t count);
   int value_remove(uint64_t value);
   int value_and(ObRoaringBitmap *rb);
   int value_or(ObRoaringBitmap *rb);
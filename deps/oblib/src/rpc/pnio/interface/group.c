@@ -715,10 +715,10 @@ void pn_print_diag_info(pn_comm_t* pn_comm) {
   // print socket diag info
   dlink_for(&pn->pktc.sk_list, p) {
     pktc_sk_t* s = structof(p, pktc_sk_t, list_link);
-    rk_info("client:%p_%s_%s_%d_%ld_%d, write_queue=%lu/%lu, write=%lu/%lu, read=%lu/%lu, doing=%lu, done=%lu, write_time=%lu, read_time=%lu, process_time=%lu",
+    rk_info("client:%p_%s_%s_%d_%ld_%d, write_queue=%lu/%lu, write=%lu/%lu, write_syscall=%lu, read=%lu/%lu, doing=%lu, done=%lu, write_time=%lu, read_time=%lu, process_time=%lu",
               s, T2S(addr, s->sk_diag_info.local_addr), T2S(addr, s->dest), s->fd, s->sk_diag_info.establish_time, s->conn_ok,
               s->wq.cnt, s->wq.sz,
-              s->sk_diag_info.write_cnt, s->sk_diag_info.write_size,
+              s->sk_diag_info.write_cnt, s->sk_diag_info.write_size, s->sk_diag_info.write_syscall_cnt,
               s->sk_diag_info.read_cnt, s->sk_diag_info.read_size,
               s->sk_diag_info.doing_cnt, s->sk_diag_info.done_cnt,
               s->sk_diag_info.write_wait_time, s->sk_diag_info.read_time, s->sk_diag_info.read_process_time);
@@ -727,10 +727,10 @@ void pn_print_diag_info(pn_comm_t* pn_comm) {
   if (pn->pkts.sk_list.next != NULL) {
     dlink_for(&pn->pkts.sk_list, p) {
       pkts_sk_t* s = structof(p, pkts_sk_t, list_link);
-      rk_info("server:%p_%s_%d_%ld, write_queue=%lu/%lu, write=%lu/%lu, read=%lu/%lu, doing=%lu, done=%lu, write_time=%lu, read_time=%lu, process_time=%lu",
+      rk_info("server:%p_%s_%d_%ld, write_queue=%lu/%lu, write=%lu/%lu, write_syscall=%lu, read=%lu/%lu, doing=%lu, done=%lu, write_time=%lu, read_time=%lu, process_time=%lu",
                 s, T2S(addr, s->peer), s->fd, s->sk_diag_info.establish_time,
                 s->wq.cnt, s->wq.sz,
-                s->sk_diag_info.write_cnt, s->sk_diag_info.write_size,
+                s->sk_diag_info.write_cnt, s->sk_diag_info.write_size, s->sk_diag_info.write_syscall_cnt,
                 s->sk_diag_info.read_cnt, s->sk_diag_info.read_size,
                 s->sk_diag_info.doing_cnt, s->sk_diag_info.done_cnt,
                 s->sk_diag_info.write_wait_time, s->sk_diag_info.read_time, s->sk_diag_info.read_process_time);
@@ -12,13 +12,18 @@
 
 str_t* sfl(dlink_t* l) { return (str_t*)(l+1); }
 int64_t cidfl(dlink_t* l) {return  *((int64_t*)l-1); }
-static int iov_from_blist(struct iovec* iov, int64_t limit, dlink_t* head) {
+// coalesce queued packets into one writev, bounded by both iov count and bytes:
+// many small packets share a syscall, while a few large packets stop the iov
+// building early as the socket send buffer can not take more anyway.
+static int iov_from_blist(struct iovec* iov, int64_t limit, int64_t bytes_limit, dlink_t* head) {
   int cnt = 0;
+  int64_t bytes = 0;
   dlink_for(head, p) {
-    if (cnt >= limit) {
+    if (cnt >= limit || bytes >= bytes_limit) {
       break;
     }
     iov_set_from_str(iov + cnt, sfl(p));
+    bytes += iov[cnt].iov_len;
     cnt++;
   }
   return cnt;
@@ -26,8 +31,8 @@ static int iov_from_blist(struct iovec* iov, int64_t limit, dlink_t* head) {
 
 static int sk_flush_blist(sock_t* s, dlink_t* head, int64_t last_pos, int64_t* wbytes) {
   int err = 0;
-  struct iovec iov[64];
-  int cnt = iov_from_blist(iov, arrlen(iov), head);
+  struct iovec iov[WQ_FLUSH_IOV_LIMIT];
+  int cnt = iov_from_blist(iov, arrlen(iov), WQ_FLUSH_BYTES_LIMIT, head);
   if (cnt > 0) {
     iov_consume_one(iov, last_pos);
     err = sk_writev(s, iov, cnt, wbytes);
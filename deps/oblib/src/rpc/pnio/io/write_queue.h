@@ -11,6 +11,8 @@
  */
 
 #define BUCKET_SIZE    1024
+#define WQ_FLUSH_IOV_LIMIT    256
+#define WQ_FLUSH_BYTES_LIMIT  (4 * 1024 * 1024)
 typedef struct write_queue_t {
   dqueue_t queue;
   int64_t pos;
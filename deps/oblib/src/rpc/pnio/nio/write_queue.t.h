@@ -36,6 +36,7 @@ static int my_sk_do_flush(my_sk_t* s, int64_t* remain) {
   int64_t flushed_time_us = rk_get_us();
   if (0 == err && NULL != h) {
     dlink_t* stop = dqueue_top(&s->wq.queue);
+    s->sk_diag_info.write_syscall_cnt ++;
     while(h != stop) {
       my_req_t* req = structof(h, my_req_t, link);
       h = h->next;
@@ -29,6 +29,7 @@ typedef struct socket_diag_info_t
   uint64_t write_cnt;
   uint64_t write_size;
   uint64_t write_wait_time;
+  uint64_t write_syscall_cnt;
   uint64_t read_cnt;
   uint64_t read_size;
   uint64_t read_time;
@@ -89,6 +89,21 @@ private:
   ObSliceAlloc alloc_;
 };
 
+struct MagazineSliceAllocWrapper: public AllocInterface
+{
+public:
+  MagazineSliceAllocWrapper(): alloc_(ISIZE, mem_attr, OB_MALLOC_BIG_BLOCK_SIZE) {
+    alloc_.set_nway(64);
+    alloc_.enable_magazine();
+  }
+  void* alloc() { return alloc_.alloc(); }
+  void free(void* p) { return alloc_.free(p); }
+  void set_nway(int nway) { alloc_.set_nway(nway); }
+  int64_t hold() { return alloc_.hold(); }
+private:
+  ObSliceAlloc alloc_;
+};
+
 struct VSliceAllocWrapper: public AllocInterface
 {
 public:
@@ -128,7 +143,7 @@ private:
   void* base_[4096];
 };
 
-FixedStack gstack[65];
+FixedStack gstack[257];
 FixedStack& get_stack() { return gstack[get_itid()]; }
 
 inline uint64_t rand64(uint64_t h)
@@ -176,10 +191,9 @@ void* thread_func(AllocInterface* ga) {
 }
 
 #define cfgi(k, d) atoi(getenv(k)?:#d)
-void do_perf(AllocInterface* ga) {
+void do_perf(AllocInterface* ga, int n_thread = cfgi("n_thread", 8)) {
   int n_sec = cfgi("n_sec", 1);
   int n_way = cfgi("n_way", 1);
-  int n_thread = cfgi("n_thread", 8);
   pthread_t thread[128];
   g_stop = false;
   ga->set_nway(n_way);
@@ -201,12 +215,26 @@ void do_perf(AllocInterface* ga) {
 }
 //int64_t get_us() { return ObTimeUtility::current_time(); }
 #define PERF(x) {fprintf(stderr, #x "\n"); x ## Wrapper ga; do_perf(&ga); }
+// contention from 1 to 128 threads
+#define PERF_SCALE(x) {                                   \
+    for (int n = 1; n <= 128; n *= 2) {                   \
+      fprintf(stderr, #x " n_thread=%d\n", n);            \
+      x ## Wrapper ga;                                    \
+      do_perf(&ga, n);                                    \
+    }                                                     \
+  }
 
 #include <locale.h>
 int main()
 {
   setlocale(LC_ALL, "");
+  if (cfgi("scale", 0)) {
+    PERF_SCALE(SliceAlloc);
+    PERF_SCALE(MagazineSliceAlloc);
+    return 0;
+  }
   PERF(SliceAlloc);
+  PERF(MagazineSliceAlloc);
   PERF(VSliceAlloc);
   PERF(Malloc);
   PERF(ObMalloc);
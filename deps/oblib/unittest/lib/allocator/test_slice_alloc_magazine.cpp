@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "lib/allocator/ob_slice_alloc.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+static const int ISIZE = 64;
+static const int THREAD_CNT = 8;
+static const int ROUND_CNT = 2000;
+static const int MAX_BATCH = 256;
+
+// Items are freed by a thread other than the one which allocated them through a shared pool,
+// so that the magazines of one cpu are filled with items allocated on another.
+class SharedPool
+{
+public:
+  void push(void *p)
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    items_.push_back(p);
+  }
+  void *pop()
+  {
+    void *p = NULL;
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!items_.empty()) {
+      p = items_.back();
+      items_.pop_back();
+    }
+    return p;
+  }
+private:
+  std::mutex lock_;
+  std::vector<void *> items_;
+};
+
+void alloc_free_func(ObSliceAlloc *alloc, SharedPool *pool, int64_t *alloc_fail_cnt)
+{
+  void *batch[MAX_BATCH];
+  for (int i = 0; i < ROUND_CNT; i++) {
+    const int cnt = 1 + (i * 37) % MAX_BATCH;
+    for (int j = 0; j < cnt; j++) {
+      if (NULL == (batch[j] = alloc->alloc())) {
+        ATOMIC_INC(alloc_fail_cnt);
+      } else {
+        memset(batch[j], 0xa5, ISIZE);
+      }
+    }
+    for (int j = 0; j < cnt; j++) {
+      if (0 == (j & 1)) {
+        alloc->free(batch[j]);
+      } else if (NULL != batch[j]) {
+        pool->push(batch[j]);
+      }
+    }
+    for (int j = 0; j < cnt / 2; j++) {
+      alloc->free(pool->pop());
+    }
+  }
+}
+
+void run_alloc_free(ObSliceAlloc &alloc)
+{
+  SharedPool pool;
+  int64_t alloc_fail_cnt = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < THREAD_CNT; i++) {
+    threads.push_back(std::thread(alloc_free_func, &alloc, &pool, &alloc_fail_cnt));
+  }
+  for (int i = 0; i < THREAD_CNT; i++) {
+    threads[i].join();
+  }
+  void *p = NULL;
+  while (NULL != (p = pool.pop())) {
+    alloc.free(p);
+  }
+  ASSERT_EQ(0, alloc_fail_cnt);
+}
+
+TEST(TestSliceAllocMagazine, enable)
+{
+  ObBlockAllocMgr blk_alloc;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "TestMagazine");
+  ObSliceAlloc not_init_alloc;
+  ASSERT_EQ(OB_NOT_INIT, not_init_alloc.enable_magazine());
+
+  ObSliceAlloc alloc(ISIZE, attr, OB_MALLOC_NORMAL_BLOCK_SIZE, blk_alloc);
+  ASSERT_EQ(0, blk_alloc.hold());
+  ASSERT_EQ(OB_SUCCESS, alloc.enable_magazine());
+  // the slots are charged to the block allocator
+  ASSERT_GT(blk_alloc.hold(), 0);
+  ASSERT_EQ(OB_INIT_TWICE, alloc.enable_magazine());
+  alloc.destroy();
+  ASSERT_EQ(0, blk_alloc.hold());
+}
+
+TEST(TestSliceAllocMagazine, purge_and_destroy)
+{
+  ObBlockAllocMgr blk_alloc;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "TestMagazine");
+  ObSliceAlloc alloc(ISIZE, attr, OB_MALLOC_NORMAL_BLOCK_SIZE, blk_alloc);
+  alloc.set_nway(THREAD_CNT);
+  ASSERT_EQ(OB_SUCCESS, alloc.enable_magazine());
+  const int64_t baseline = blk_alloc.hold();
+
+  run_alloc_free(alloc);
+  // all the items are freed, but the magazines still hold some of them
+  ASSERT_GE(blk_alloc.hold(), baseline);
+  alloc.purge_magazine();
+  alloc.purge_extra_cached_block(0);
+  ASSERT_EQ(baseline, blk_alloc.hold());
+
+  // the magazines are reloaded after purge
+  run_alloc_free(alloc);
+  alloc.purge_magazine();
+  alloc.purge_extra_cached_block(0);
+  ASSERT_EQ(baseline, blk_alloc.hold());
+
+  // destroy without purging first leaks no block
+  run_alloc_free(alloc);
+  alloc.destroy();
+  ASSERT_EQ(0, blk_alloc.hold());
+}
+
+TEST(TestSliceAllocMagazine, without_magazine)
+{
+  ObBlockAllocMgr blk_alloc;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "TestMagazine");
+  ObSliceAlloc alloc(ISIZE, attr, OB_MALLOC_NORMAL_BLOCK_SIZE, blk_alloc);
+  alloc.set_nway(THREAD_CNT);
+  run_alloc_free(alloc);
+  // purge_magazine is a no-op when the magazine is not enabled
+  alloc.purge_magazine();
+  alloc.purge_extra_cached_block(0);
+  ASSERT_EQ(0, blk_alloc.hold());
+  alloc.destroy();
+  ASSERT_EQ(0, blk_alloc.hold());
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,7 @@
 #include <time.h>
 #include <sys/time.h>
 #include <codecvt>
+#include <vector>
 #include "gtest/gtest.h"
 
 #define protected public
@@ -383,6 +384,98 @@ TEST_F(TestCharset, test_max_byte_char_pos)
   }
 }
 
+TEST_F(TestCharset, utf8mb4_length_functions)
+{
+  const ObCharsetInfo *cs = ObCharset::get_charset(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_TRUE(NULL != cs);
+  const char *ill_formed[] = {"\x80", "\xc0\x80", "\xe0\x80\x80", "\xf4\x90\x80\x80", "\xff", "\xe4\xb8"};
+  // the seed is printed on failure to reproduce it
+  const unsigned seed = static_cast<unsigned>(time(NULL));
+  SCOPED_TRACE(testing::Message() << "seed=" << seed);
+  std::srand(seed);
+  // a random offset of str which is not in the middle of a character, str is valid utf8
+  auto random_char_boundary = [this](const std::string &str) {
+    std::vector<size_t> boundaries;
+    for (size_t pos = 0; pos < str.length(); ++pos) {
+      if (0x80 != (static_cast<unsigned char>(str[pos]) & 0xc0)) {
+        boundaries.push_back(pos);
+      }
+    }
+    boundaries.push_back(str.length());
+    return boundaries[random_range(0, boundaries.size())];
+  };
+  for (int64_t i = 0; i < 1000; ++i) {
+    char buf[512];
+    int real_len = 0;
+    gen_random_unicode_string(random_range(0, 200), buf, real_len);
+    std::string str(buf, real_len);
+    // long ascii runs take the block path
+    str.insert(random_char_boundary(str), std::string(random_range(0, 100), 'a'));
+    if (0 == i % 3) {
+      str.insert(random_char_boundary(str), ill_formed[i % (sizeof(ill_formed) / sizeof(ill_formed[0]))]);
+    }
+    const char *b = str.data();
+    const char *e = b + str.length();
+    ASSERT_EQ(ob_numchars_mb(cs, b, e), cs->cset->numchars(cs, b, e));
+    const size_t length = random_range(0, str.length() + 2);
+    ASSERT_EQ(ob_charpos_mb(cs, b, e, length), cs->cset->charpos(cs, b, e, length));
+    size_t char_len = 0;
+    size_t expected_char_len = 0;
+    ASSERT_EQ(ob_max_bytes_charpos_mb(cs, b, e, length, &expected_char_len),
+              cs->cset->max_bytes_charpos(cs, b, e, length, &char_len));
+    ASSERT_EQ(expected_char_len, char_len);
+    int error = 0;
+    const size_t well_formed_len = cs->cset->well_formed_len(cs, b, e, UINT64_MAX, &error);
+    ASSERT_EQ(0 == i % 3, 1 == error);
+    if (0 == error) {
+      ASSERT_EQ(str.length(), well_formed_len);
+    } else {
+      // the well formed prefix
+      ASSERT_EQ(well_formed_len, cs->cset->well_formed_len(cs, b, b + well_formed_len, UINT64_MAX, &error));
+      ASSERT_EQ(0, error);
+    }
+  }
+}
+
+TEST_F(TestCharset, uca_900_sortkey_var_len)
+{
+  ASSERT_TRUE(ObCharset::is_uca_900_nopad(CS_TYPE_UTF8MB4_0900_AI_CI));
+  ASSERT_TRUE(ObCharset::is_uca_900_nopad(CS_TYPE_UTF8MB4_ZH_0900_AS_CS));
+  ASSERT_FALSE(ObCharset::is_uca_900_nopad(CS_TYPE_UTF8MB4_UNICODE_CI));
+  ASSERT_FALSE(ObCharset::is_uca_900_nopad(CS_TYPE_UTF8MB4_GENERAL_CI));
+  ObCollationType coll_types[] = {CS_TYPE_UTF8MB4_0900_AI_CI, CS_TYPE_UTF8MB4_ZH_0900_AS_CS};
+  const char *strs[] = {"", "\0", "a", "A", "a ", "ab", "\xc3\xa4", "\xc3\x9f", "ss", "\xe4\xb8\xad", "\xf0\x9f\x98\x80"};
+  const int64_t str_cnt = sizeof(strs) / sizeof(strs[0]);
+  for (int64_t c = 0; c < sizeof(coll_types) / sizeof(coll_types[0]); ++c) {
+    ObCollationType coll_type = coll_types[c];
+    for (int64_t i = 0; i < str_cnt; ++i) {
+      for (int64_t j = 0; j < str_cnt; ++j) {
+        const int64_t len1 = (1 == i) ? 1 : strlen(strs[i]);
+        const int64_t len2 = (1 == j) ? 1 : strlen(strs[j]);
+        char key1[256];
+        char key2[256];
+        bool is_valid1 = false;
+        bool is_valid2 = false;
+        int64_t key_len1 = ObCharset::sortkey_var_len(coll_type, strs[i], len1, key1, sizeof(key1), true, is_valid1);
+        int64_t key_len2 = ObCharset::sortkey_var_len(coll_type, strs[j], len2, key2, sizeof(key2), true, is_valid2);
+        ASSERT_TRUE(is_valid1 && is_valid2);
+        int cmp = memcmp(key1, key2, std::min(key_len1, key_len2));
+        if (0 == cmp) {
+          cmp = key_len1 < key_len2 ? -1 : (key_len1 > key_len2 ? 1 : 0);
+        }
+        int expected = ObCharset::strcmp(coll_type, strs[i], len1, strs[j], len2);
+        ASSERT_EQ(expected > 0, cmp > 0) << coll_type << " " << i << " " << j;
+        ASSERT_EQ(expected < 0, cmp < 0) << coll_type << " " << i << " " << j;
+      }
+    }
+    // the weight string is truncated
+    char key[8];
+    bool is_valid = true;
+    ObCharset::sortkey_var_len(coll_type, "abcdefgh", 8, key, sizeof(key), true, is_valid);
+    ASSERT_FALSE(is_valid);
+  }
+}
+
 TEST_F(TestCharset, test_ascii_list_for_all_charset)
 {
   const int64_t buf_len = 100;
@@ -29,6 +29,50 @@ namespace oceanbase
 namespace libobcdc
 {
 
+int IObCDCInstance::next_records(ICDCRecord **records,
+    const int64_t max_count,
+    int64_t &record_count,
+    const int64_t timeout_us)
+{
+  int ret = OB_SUCCESS;
+  record_count = 0;
+
+  if (OB_ISNULL(records) || OB_UNLIKELY(max_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    OBLOG_LOG(ERROR, "invalid argument", KR(ret), KP(records), K(max_count));
+  } else {
+    // Only wait for the first record, the rest records are taken if they are ready, so that
+    // the consumer can amortize the cost of each call over a batch of records.
+    while (OB_SUCC(ret) && record_count < max_count) {
+      const int64_t wait_timeout_us = (0 == record_count) ? timeout_us : 0;
+
+      if (OB_FAIL(next_record(records + record_count, wait_timeout_us))) {
+        if (OB_TIMEOUT != ret && OB_IN_STOP_STATE != ret) {
+          OBLOG_LOG(ERROR, "next record fail", KR(ret), K(record_count), K(max_count));
+        }
+      } else {
+        record_count++;
+      }
+    }
+
+    if (OB_TIMEOUT == ret && record_count > 0) {
+      ret = OB_SUCCESS;
+    }
+  }
+
+  return ret;
+}
+
+void IObCDCInstance::release_records(ICDCRecord **records, const int64_t record_count)
+{
+  if (NULL != records) {
+    for (int64_t idx = 0; idx < record_count; idx++) {
+      release_record(records[idx]);
+      records[idx] = NULL;
+    }
+  }
+}
+
 ObCDCFactory::ObCDCFactory()
 {
   // set max memory limit
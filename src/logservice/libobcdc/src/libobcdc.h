@@ -138,6 +138,33 @@ public:
   /// @retval OB_SUCCESS      success
   /// @retval other value     fail
   virtual int get_tenant_ids(std::vector<uint64_t> &tenant_ids) = 0;
+
+  /*
+   * fetch a batch of binlog records from OB cluster
+   * wait at most timeout_us for the first record, then take the records which are already
+   * available without waiting, until max_count records are fetched.
+   * the default implementation calls next_record() repeatedly.
+   * @param [out] records       array of at least max_count records, each record should be released
+   *                            by release_record() or release_records()
+   * @param [in]  max_count     max count of records to fetch
+   * @param [out] record_count  count of records fetched, which is greater than 0 on success
+   *
+   * @param OB_SUCCESS          success
+   * @param OB_TIMEOUT          timeout, no record fetched
+   * @param other error code    fail, records fetched before the failure are still returned
+   */
+  virtual int next_records(ICDCRecord **records,
+      const int64_t max_count,
+      int64_t &record_count,
+      const int64_t timeout_us);
+
+  /*
+   * release a batch of records fetched by next_records()
+   * the default implementation calls release_record() for each record.
+   * @param records
+   * @param record_count
+   */
+  virtual void release_records(ICDCRecord **records, const int64_t record_count);
 };
 
 class ObCDCFactory
@@ -188,6 +188,10 @@ public:
   DEF_INT(binlog_record_prealloc_count, OB_CLUSTER_PARAMETER, "200000", "[1,]", "binlog record pre-alloc count");
 
   DEF_STR(store_service_path, OB_CLUSTER_PARAMETER, "./storage", "store sevice path");
+  // rocksdb: store redo of large transactions in rocksdb
+  // file: store redo of large transactions in append-only segment files
+  DEF_STR(store_service_type, OB_CLUSTER_PARAMETER, "rocksdb", "store service type: rocksdb, file");
+  T_DEF_INT_INFT(file_store_segment_size, OB_CLUSTER_PARAMETER, 64, 1, "segment file size of file store service[M]");
 
   // Whether to do ob version compatibility check
   // default value '0:not_skip'
@@ -0,0 +1,592 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Append-only segment file store service
+ */
+
+#define USING_LOG_PREFIX OBLOG_STORAGER
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "ob_log_file_store_service.h"
+#include "ob_log_utils.h"
+#include "ob_log_config.h"
+#include "lib/utility/ob_print_utils.h"     // databuff_printf
+#include "lib/file/file_directory_utils.h"  // FileDirectoryUtils
+#include "lib/oblog/ob_log_module.h"        // LOG_*
+#include "lib/ob_errno.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace libobcdc
+{
+ObLogFileStoreService::ObLogFileStoreService() :
+    is_inited_(false),
+    is_stopped_(true),
+    store_path_(),
+    segment_size_(0),
+    next_cf_id_(0),
+    default_cf_(NULL)
+{
+}
+
+ObLogFileStoreService::~ObLogFileStoreService()
+{
+  destroy();
+}
+
+int ObLogFileStoreService::init(const std::string &path)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(is_inited_)) {
+    LOG_ERROR("ObLogFileStoreService has inited twice");
+    ret = OB_INIT_TWICE;
+  } else if (OB_FAIL(init_dir_(path.c_str()))) {
+    LOG_ERROR("init_dir_ fail", K(ret));
+  } else {
+    store_path_ = path;
+    segment_size_ = TCONF.file_store_segment_size * MB;
+    next_cf_id_ = 0;
+
+    if (OB_FAIL(create_column_family_("default", default_cf_))) {
+      LOG_ERROR("create default column family fail", K(ret));
+    } else {
+      _LOG_INFO("ObLogFileStoreService init success, path:%s, segment_size=%ld",
+          store_path_.c_str(), segment_size_);
+      is_stopped_ = false;
+      is_inited_ = true;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::close()
+{
+  mark_stop_flag();
+  LOG_INFO("file store service close succ");
+  return OB_SUCCESS;
+}
+
+void ObLogFileStoreService::destroy()
+{
+  if (is_inited_) {
+    LOG_INFO("file store service destroy begin");
+    close();
+
+    if (OB_NOT_NULL(default_cf_)) {
+      (void)drop_column_family(default_cf_);
+      (void)destory_column_family(default_cf_);
+      default_cf_ = NULL;
+    }
+    store_path_.clear();
+    segment_size_ = 0;
+    next_cf_id_ = 0;
+    is_inited_ = false;
+    LOG_INFO("file store service destroy end");
+  }
+}
+
+int ObLogFileStoreService::init_dir_(const char *dir_path)
+{
+  int ret = OB_SUCCESS;
+  bool is_exist = false;
+
+  if (OB_FAIL(FileDirectoryUtils::is_exists(dir_path, is_exist))) {
+    LOG_ERROR("FileDirectoryUtils is_exists fail", K(ret), K(dir_path));
+  } else if (is_exist && OB_FAIL(FileDirectoryUtils::delete_directory_rec(dir_path))) {
+    LOG_ERROR("FileDirectoryUtils delete_directory_rec fail", K(ret), K(dir_path));
+  } else if (OB_FAIL(FileDirectoryUtils::create_full_path(dir_path))) {
+    LOG_ERROR("FileDirectoryUtils create_full_path fail", K(ret), K(dir_path));
+  } else {
+    // succ
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::put(const std::string &key, const ObSlice &value)
+{
+  return put(default_cf_, key, value);
+}
+
+int ObLogFileStoreService::put(void *cf_handle, const std::string &key, const ObSlice &value)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+  ValueLocation location;
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else if (OB_FAIL(reserve_(*cf, value.buf_len_, location))) {
+    if (OB_IN_STOP_STATE != ret) {
+      LOG_ERROR("reserve space in segment fail", K(ret), "cf", cf->name_.c_str(), K(value.buf_len_));
+    }
+  } else {
+    // the value is written outside the lock, and it becomes visible after it is indexed
+    const int write_ret = write_(location, value);
+    ObSpinLockGuard guard(cf->lock_);
+
+    if (OB_SUCCESS != write_ret) {
+      ret = write_ret;
+      dec_segment_ref_(*cf, location.segment_);
+    } else {
+      std::pair<std::map<std::string, ValueLocation>::iterator, bool> res =
+          cf->index_.insert(std::make_pair(key, location));
+
+      if (! res.second) {
+        // overwrite the old value
+        cf->live_data_size_ -= res.first->second.len_;
+        dec_segment_ref_(*cf, res.first->second.segment_);
+        res.first->second = location;
+      }
+      cf->live_data_size_ += location.len_;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::batch_write(void *cf_handle,
+    const std::vector<std::string> &keys,
+    const std::vector<ObSlice> &values)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(cf_handle)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (OB_UNLIKELY(keys.size() != values.size())) {
+    LOG_ERROR("keys and values count not match", "key_cnt", keys.size(), "value_cnt", values.size());
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < keys.size(); ++idx) {
+      if (OB_FAIL(put(cf_handle, keys[idx], values[idx]))) {
+        if (OB_IN_STOP_STATE != ret) {
+          LOG_ERROR("put value fail", K(ret), K(idx));
+        }
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::get(const std::string &key, std::string &value)
+{
+  return get(default_cf_, key, value);
+}
+
+int ObLogFileStoreService::get(void *cf_handle, const std::string &key, std::string &value)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+  ValueLocation location;
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    {
+      ObSpinLockGuard guard(cf->lock_);
+      std::map<std::string, ValueLocation>::iterator iter = cf->index_.find(key);
+
+      if (cf->index_.end() == iter) {
+        ret = OB_ENTRY_NOT_EXIST;
+      } else {
+        // hold the segment until the value is read
+        location = iter->second;
+        location.segment_->ref_cnt_++;
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      ret = read_(location, value);
+      ObSpinLockGuard guard(cf->lock_);
+      dec_segment_ref_(*cf, location.segment_);
+    }
+
+    if (OB_FAIL(ret) && OB_ENTRY_NOT_EXIST != ret) {
+      _LOG_ERROR("ObLogFileStoreService get value failed, ret=%d, key:%s", ret, key.c_str());
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::del(const std::string &key)
+{
+  return del(default_cf_, key);
+}
+
+int ObLogFileStoreService::del(void *cf_handle, const std::string &key)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("column_family_handle is NULL", KR(ret));
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    ObSpinLockGuard guard(cf->lock_);
+    std::map<std::string, ValueLocation>::iterator iter = cf->index_.find(key);
+
+    // deleting a non-exist key is not an error, which is the same as rocksdb
+    if (cf->index_.end() != iter) {
+      cf->live_data_size_ -= iter->second.len_;
+      dec_segment_ref_(*cf, iter->second.segment_);
+      cf->index_.erase(iter);
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::del_range(void *cf_handle, const std::string &begin_key, const std::string &end_key)
+{
+  int ret = OB_SUCCESS;
+  int64_t start_ts = get_timestamp();
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+  int64_t del_cnt = 0;
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_ERR_UNEXPECTED;
+  } else if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    ObSpinLockGuard guard(cf->lock_);
+    // [begin_key, end_key), which is the same as rocksdb DeleteRange
+    std::map<std::string, ValueLocation>::iterator iter = cf->index_.lower_bound(begin_key);
+
+    while (cf->index_.end() != iter && iter->first < end_key) {
+      cf->live_data_size_ -= iter->second.len_;
+      dec_segment_ref_(*cf, iter->second.segment_);
+      iter = cf->index_.erase(iter);
+      del_cnt++;
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    double time_cost = (get_timestamp() - start_ts)/1000.0;
+    _LOG_INFO("DEL_RANGE time_cost=%.3lfms start_key=%s end_key=%s del_cnt=%ld",
+        time_cost, begin_key.c_str(), end_key.c_str(), del_cnt);
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::compact_range(
+    void *cf_handle,
+    const std::string &begin_key,
+    const std::string &end_key,
+    const bool op_entire_cf)
+{
+  UNUSED(begin_key);
+  UNUSED(end_key);
+  UNUSED(op_entire_cf);
+  return OB_ISNULL(cf_handle) ? OB_ERR_UNEXPECTED : OB_SUCCESS;
+}
+
+int ObLogFileStoreService::flush(void *cf_handle)
+{
+  return OB_ISNULL(cf_handle) ? OB_ERR_UNEXPECTED : OB_SUCCESS;
+}
+
+int ObLogFileStoreService::create_column_family(const std::string& column_family_name,
+    void *&cf_handle)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = NULL;
+
+  if (is_stopped()) {
+    ret = OB_IN_STOP_STATE;
+  } else if (OB_FAIL(create_column_family_(column_family_name, cf))) {
+    LOG_ERROR("create column family fail", K(ret), "column_family_name", column_family_name.c_str());
+  } else {
+    cf_handle = reinterpret_cast<void *>(cf);
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::create_column_family_(const std::string &column_family_name,
+    ColumnFamily *&cf)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(cf = new(std::nothrow) ColumnFamily())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("alloc column family fail", K(ret));
+  } else {
+    cf->cf_id_ = ATOMIC_FAA(&next_cf_id_, 1);
+    cf->name_ = column_family_name;
+    LOG_INFO("file store CreateColumnFamily succ", "column_family_name", column_family_name.c_str(),
+        "cf_id", cf->cf_id_, K(cf));
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::drop_column_family(void *cf_handle)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    ObSpinLockGuard guard(cf->lock_);
+    std::map<std::string, ValueLocation>::iterator iter = cf->index_.begin();
+
+    for (; cf->index_.end() != iter; ++iter) {
+      dec_segment_ref_(*cf, iter->second.segment_);
+    }
+    cf->index_.clear();
+    cf->live_data_size_ = 0;
+
+    if (OB_NOT_NULL(cf->cur_segment_)) {
+      seal_segment_(*cf, cf->cur_segment_);
+      cf->cur_segment_ = NULL;
+    }
+    cf->is_dropped_ = true;
+    LOG_INFO("file store DropColumnFamily succ", "column_family_name", cf->name_.c_str(),
+        "remain_segment_cnt", cf->segment_cnt_);
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::destory_column_family(void *cf_handle)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    LOG_ERROR("column_family_handle is NULL");
+    ret = OB_INVALID_ARGUMENT;
+  } else if (OB_UNLIKELY(! cf->is_dropped_ || 0 != cf->segment_cnt_)) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_ERROR("column family is still in use", K(ret), "column_family_name", cf->name_.c_str(),
+        "is_dropped", cf->is_dropped_, "segment_cnt", cf->segment_cnt_);
+  } else {
+    LOG_INFO("file store DestroyColumnFamily succ", "column_family_name", cf->name_.c_str());
+    delete cf;
+    cf = NULL;
+  }
+
+  return ret;
+}
+
+void ObLogFileStoreService::get_mem_usage(const std::vector<uint64_t> ids,
+    const std::vector<void *> cf_handles)
+{
+  int ret = OB_SUCCESS;
+  int64_t total_live_data_size = 0;
+  int64_t total_num_keys = 0;
+
+  for (int64_t idx = 0; OB_SUCC(ret) && !is_stopped() && idx < cf_handles.size(); ++idx) {
+    int64_t live_data_size = 0;
+    int64_t num_keys = 0;
+
+    if (OB_FAIL(get_mem_usage(cf_handles[idx], live_data_size, num_keys))) {
+      LOG_ERROR("get_mem_usage fail", K(ret), K(idx));
+    } else {
+      total_live_data_size += live_data_size;
+      total_num_keys += num_keys;
+      _LOG_INFO("[STORE_SERVICE] [FILE_STORE] tenant_id=%lu live_data=%s num_keys=%ld",
+          idx < ids.size() ? ids[idx] : OB_INVALID_TENANT_ID, SIZE_TO_STR(live_data_size), num_keys);
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    _LOG_INFO("[STORE_SERVICE] [FILE_STORE] total live_data=%s num_keys=%ld",
+        SIZE_TO_STR(total_live_data_size), total_num_keys);
+  }
+}
+
+int ObLogFileStoreService::get_mem_usage(void * cf_handle,
+    int64_t &estimate_live_data_size,
+    int64_t &estimate_num_keys)
+{
+  int ret = OB_SUCCESS;
+  ColumnFamily *cf = static_cast<ColumnFamily *>(cf_handle);
+
+  if (OB_ISNULL(cf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("column_family_handle is NULL", K(ret));
+  } else {
+    ObSpinLockGuard guard(cf->lock_);
+    estimate_live_data_size = cf->live_data_size_;
+    estimate_num_keys = cf->index_.size();
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::reserve_(ColumnFamily &cf, const int64_t len, ValueLocation &location)
+{
+  int ret = OB_SUCCESS;
+  ObSpinLockGuard guard(cf.lock_);
+  Segment *segment = cf.cur_segment_;
+
+  if (OB_UNLIKELY(cf.is_dropped_)) {
+    ret = OB_IN_STOP_STATE;
+  } else {
+    // a value larger than the segment size takes a segment alone
+    if (OB_NOT_NULL(segment) && segment->write_pos_ > 0 && segment->write_pos_ + len > segment_size_) {
+      seal_segment_(cf, segment);
+      segment = NULL;
+      cf.cur_segment_ = NULL;
+    }
+
+    if (OB_ISNULL(segment) && OB_FAIL(open_segment_(cf, segment))) {
+      LOG_ERROR("open segment fail", K(ret), "cf", cf.name_.c_str());
+    } else {
+      cf.cur_segment_ = segment;
+      location.segment_ = segment;
+      location.offset_ = segment->write_pos_;
+      location.len_ = len;
+      segment->write_pos_ += len;
+      // released when the value is deleted
+      segment->ref_cnt_++;
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::open_segment_(ColumnFamily &cf, Segment *&segment)
+{
+  int ret = OB_SUCCESS;
+  const static int64_t PATH_BUF_SIZE = 1024;
+  char path_buf[PATH_BUF_SIZE];
+  int64_t pos = 0;
+  segment = NULL;
+
+  if (OB_FAIL(databuff_printf(path_buf, PATH_BUF_SIZE, pos, "%s/%ld_%ld.seg",
+      store_path_.c_str(), cf.cf_id_, cf.next_seg_id_))) {
+    LOG_ERROR("databuff_printf fail", K(ret), "cf_id", cf.cf_id_, "seg_id", cf.next_seg_id_);
+  } else if (OB_ISNULL(segment = new(std::nothrow) Segment())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("alloc segment fail", K(ret));
+  } else if (-1 == (segment->fd_ = ::open(path_buf, O_RDWR | O_CREAT | O_TRUNC, 0644))) {
+    ret = OB_IO_ERROR;
+    LOG_ERROR("open segment file fail", K(ret), K(errno), K(path_buf));
+    delete segment;
+    segment = NULL;
+  } else {
+    // values are read back in the order they are written, let the kernel read ahead aggressively
+    (void)posix_fadvise(segment->fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    segment->seg_id_ = cf.next_seg_id_++;
+    segment->path_ = path_buf;
+    cf.segment_cnt_++;
+  }
+
+  return ret;
+}
+
+void ObLogFileStoreService::seal_segment_(ColumnFamily &cf, Segment *segment)
+{
+  if (OB_NOT_NULL(segment)) {
+    segment->is_sealed_ = true;
+
+    if (0 == segment->ref_cnt_) {
+      remove_segment_(cf, segment);
+    }
+  }
+}
+
+void ObLogFileStoreService::dec_segment_ref_(ColumnFamily &cf, Segment *segment)
+{
+  if (OB_NOT_NULL(segment)) {
+    segment->ref_cnt_--;
+
+    if (0 == segment->ref_cnt_ && segment->is_sealed_) {
+      remove_segment_(cf, segment);
+    }
+  }
+}
+
+void ObLogFileStoreService::remove_segment_(ColumnFamily &cf, Segment *segment)
+{
+  if (OB_NOT_NULL(segment)) {
+    if (-1 != segment->fd_) {
+      (void)::close(segment->fd_);
+      segment->fd_ = -1;
+    }
+    if (0 != ::unlink(segment->path_.c_str())) {
+      LOG_WARN_RET(OB_IO_ERROR, "unlink segment file fail", K(errno), "path", segment->path_.c_str());
+    }
+    cf.segment_cnt_--;
+    delete segment;
+  }
+}
+
+int ObLogFileStoreService::write_(const ValueLocation &location, const ObSlice &value)
+{
+  int ret = OB_SUCCESS;
+  int64_t write_size = 0;
+
+  while (OB_SUCC(ret) && write_size < value.buf_len_) {
+    const ssize_t size = ::pwrite(location.segment_->fd_, value.buf_ + write_size,
+        value.buf_len_ - write_size, location.offset_ + write_size);
+
+    if (size > 0) {
+      write_size += size;
+    } else if (-1 == size && EINTR == errno) {
+      // retry
+    } else {
+      ret = OB_IO_ERROR;
+      LOG_ERROR("pwrite segment file fail", K(ret), K(errno), "path", location.segment_->path_.c_str(),
+          K(location.offset_), K(location.len_), K(write_size));
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFileStoreService::read_(const ValueLocation &location, std::string &value)
+{
+  int ret = OB_SUCCESS;
+  int64_t read_size = 0;
+  value.resize(location.len_);
+
+  while (OB_SUCC(ret) && read_size < location.len_) {
+    const ssize_t size = ::pread(location.segment_->fd_, &value[read_size],
+        location.len_ - read_size, location.offset_ + read_size);
+
+    if (size > 0) {
+      read_size += size;
+    } else if (-1 == size && EINTR == errno) {
+      // retry
+    } else {
+      ret = OB_IO_ERROR;
+      LOG_ERROR("pread segment file fail", K(ret), K(errno), "path", location.segment_->path_.c_str(),
+          K(location.offset_), K(location.len_), K(read_size));
+    }
+  }
+
+  return ret;
+}
+
+}
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Append-only segment file store service
+ */
+
+#ifndef OCEANBASE_LIBOBCDC_OB_LOG_FILE_STORE_SERVICE_H_
+#define OCEANBASE_LIBOBCDC_OB_LOG_FILE_STORE_SERVICE_H_
+
+#include <map>
+#include "ob_log_store_service.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/lock/ob_spin_lock.h"
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+// Redo of large transactions is written once, read once in order and then deleted, so it is
+// not necessary to pay the write amplification and compaction cost of a LSM tree.
+//
+// ObLogFileStoreService appends values into segment files of each column family and keeps the
+// location of each key in memory. A segment file is removed as soon as all values in it have
+// been deleted, so deleted data never needs to be compacted.
+//
+// NOTICE: data is not persisted across restart, the store path is cleaned up in init, which is
+// the same as RocksDbStoreService.
+class ObLogFileStoreService : public IObStoreService
+{
+public:
+  ObLogFileStoreService();
+  virtual ~ObLogFileStoreService();
+  int init(const std::string &path);
+  void destroy();
+
+public:
+  virtual int put(const std::string &key, const ObSlice &value);
+  virtual int put(void *cf_handle, const std::string &key, const ObSlice &value);
+
+  virtual int batch_write(void *cf_handle, const std::vector<std::string> &keys, const std::vector<ObSlice> &values);
+
+  virtual int get(const std::string &key, std::string &value);
+  virtual int get(void *cf_handle, const std::string &key, std::string &value);
+
+  virtual int del(const std::string &key);
+  virtual int del(void *cf_handle, const std::string &key);
+  virtual int del_range(void *cf_handle, const std::string &begin_key, const std::string &end_key);
+  // segment files are reclaimed on deletion, nothing to compact or flush
+  virtual int compact_range(
+      void *cf_handle,
+      const std::string &begin_key,
+      const std::string &end_key,
+      const bool op_entire_cf = false);
+  virtual int flush(void *cf_handle);
+
+  virtual int create_column_family(const std::string& column_family_name,
+      void *&cf_handle);
+  virtual int drop_column_family(void *cf_handle);
+  virtual int destory_column_family(void *cf_handle);
+
+  virtual void mark_stop_flag() override { ATOMIC_SET(&is_stopped_, true); }
+  virtual int close() override;
+  virtual void get_mem_usage(const std::vector<uint64_t> ids,
+      const std::vector<void *> cf_handles);
+  virtual int get_mem_usage(void * cf_handle, int64_t &estimate_live_data_size, int64_t &estimate_num_keys);
+  OB_INLINE bool is_stopped() const { return ATOMIC_LOAD(&is_stopped_); }
+
+private:
+  struct Segment
+  {
+    Segment() : seg_id_(0), fd_(-1), write_pos_(0), ref_cnt_(0), is_sealed_(false), path_() {}
+
+    int64_t seg_id_;
+    int fd_;
+    // offset reserved by writers
+    int64_t write_pos_;
+    // values stored in the segment, plus the in-flight reads and writes
+    int64_t ref_cnt_;
+    bool is_sealed_;
+    std::string path_;
+  };
+
+  struct ValueLocation
+  {
+    ValueLocation() : segment_(NULL), offset_(0), len_(0) {}
+    ValueLocation(Segment *segment, const int64_t offset, const int64_t len)
+      : segment_(segment), offset_(offset), len_(len) {}
+
+    Segment *segment_;
+    int64_t offset_;
+    int64_t len_;
+  };
+
+  struct ColumnFamily
+  {
+    ColumnFamily() : cf_id_(0), name_(), lock_(), cur_segment_(NULL), next_seg_id_(0),
+        index_(), live_data_size_(0), segment_cnt_(0), is_dropped_(false) {}
+
+    int64_t cf_id_;
+    std::string name_;
+    common::ObSpinLock lock_;
+    Segment *cur_segment_;
+    int64_t next_seg_id_;
+    std::map<std::string, ValueLocation> index_;
+    int64_t live_data_size_;
+    int64_t segment_cnt_;
+    bool is_dropped_;
+  };
+
+private:
+  int init_dir_(const char *dir_path);
+  int create_column_family_(const std::string &column_family_name, ColumnFamily *&cf);
+  int reserve_(ColumnFamily &cf, const int64_t len, ValueLocation &location);
+  int open_segment_(ColumnFamily &cf, Segment *&segment);
+  void seal_segment_(ColumnFamily &cf, Segment *segment);
+  void dec_segment_ref_(ColumnFamily &cf, Segment *segment);
+  void remove_segment_(ColumnFamily &cf, Segment *segment);
+  int write_(const ValueLocation &location, const ObSlice &value);
+  int read_(const ValueLocation &location, std::string &value);
+
+private:
+  static const int64_t MB = 1024L * 1024L;
+  bool is_inited_;
+  bool is_stopped_;
+  std::string store_path_;
+  int64_t segment_size_;
+  int64_t next_cf_id_;
+  ColumnFamily *default_cf_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLogFileStoreService);
+};
+
+}
+}
+
+#endif
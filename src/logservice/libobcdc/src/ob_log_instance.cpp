@@ -60,6 +60,7 @@
 #include "ob_log_start_schema_matcher.h"  // ObLogStartSchemaMatcher
 #include "ob_log_tenant_mgr.h"            // IObLogTenantMgr
 #include "ob_log_rocksdb_store_service.h" // RocksDbStoreService
+#include "ob_log_file_store_service.h"    // ObLogFileStoreService
 #include "ob_cdc_auto_config_mgr.h"       // CDC_CFG_MGR
 #include "ob_cdc_malloc_sample_info.h"    // ObCDCMallocSampleInfo
 
@@ -750,6 +751,7 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
   // The starting schema version of the SYS tenant
   const char *data_start_schema_version = TCONF.data_start_schema_version.str();
   const char *store_service_path = TCONF.store_service_path.str();
+  const char *store_service_type = TCONF.store_service_type.str();
   const char *working_mode_str = TCONF.working_mode.str();
   WorkingMode working_mode = get_working_mode(working_mode_str);
   const char *refresh_mode_str = TCONF.meta_data_refresh_mode.str();
@@ -900,7 +902,16 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
 
   INIT(log_entry_task_pool_, ObLogEntryTaskPool, TCONF.log_entry_task_prealloc_count);
 
-  INIT(store_service_, RocksDbStoreService, store_service_path);
+  if (OB_SUCC(ret)) {
+    if (0 == strcmp("file", store_service_type)) {
+      INIT(store_service_, ObLogFileStoreService, store_service_path);
+    } else if (0 == strcmp("rocksdb", store_service_type)) {
+      INIT(store_service_, RocksDbStoreService, store_service_path);
+    } else {
+      ret = OB_INVALID_CONFIG;
+      LOG_ERROR("invalid store_service_type", KR(ret), K(store_service_type));
+    }
+  }
 
   INIT(br_pool_, ObLogBRPool, TCONF.binlog_record_prealloc_count);
 
@@ -0,0 +1,302 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_log_compression.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "lib/time/ob_time_utility.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+#include "share/ob_cluster_version.h"
+#include "share/allocator/ob_tenant_mutil_allocator.h"
+#include "share/rc/ob_tenant_base.h"
+#include "ob_log_base_header.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace logservice
+{
+LogCompressedPayloadHeader::LogCompressedPayloadHeader()
+  : magic_(0),
+    version_(0),
+    compressor_type_(INVALID_COMPRESSOR),
+    original_len_(0)
+{
+}
+
+LogCompressedPayloadHeader::LogCompressedPayloadHeader(const ObCompressorType compressor_type,
+                                                       const int64_t original_len)
+  : magic_(MAGIC),
+    version_(VERSION),
+    compressor_type_(compressor_type),
+    original_len_(original_len)
+{
+}
+
+void LogCompressedPayloadHeader::reset()
+{
+  magic_ = 0;
+  version_ = 0;
+  compressor_type_ = INVALID_COMPRESSOR;
+  original_len_ = 0;
+}
+
+bool LogCompressedPayloadHeader::is_valid() const
+{
+  return MAGIC == magic_
+      && VERSION == version_
+      && compressor_type_ > NONE_COMPRESSOR
+      && compressor_type_ < MAX_COMPRESSOR
+      && original_len_ > 0;
+}
+
+DEFINE_SERIALIZE(LogCompressedPayloadHeader)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf) || buf_len <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    CLOG_LOG(WARN, "invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_FAIL(serialization::encode_i16(buf, buf_len, pos, magic_))) {
+    CLOG_LOG(WARN, "serialize magic_ failed", K(ret), KP(buf), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_i16(buf, buf_len, pos, version_))) {
+    CLOG_LOG(WARN, "serialize version_ failed", K(ret), KP(buf), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_i32(buf, buf_len, pos, compressor_type_))) {
+    CLOG_LOG(WARN, "serialize compressor_type_ failed", K(ret), KP(buf), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_i64(buf, buf_len, pos, original_len_))) {
+    CLOG_LOG(WARN, "serialize original_len_ failed", K(ret), KP(buf), K(buf_len), K(pos));
+  }
+  return ret;
+}
+
+DEFINE_DESERIALIZE(LogCompressedPayloadHeader)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf) || data_len <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    CLOG_LOG(WARN, "invalid argument", K(ret), KP(buf), K(data_len));
+  } else if (OB_FAIL(serialization::decode_i16(buf, data_len, pos, &magic_))) {
+    CLOG_LOG(WARN, "deserialize magic_ failed", K(ret), KP(buf), K(data_len), K(pos));
+  } else if (OB_FAIL(serialization::decode_i16(buf, data_len, pos, &version_))) {
+    CLOG_LOG(WARN, "deserialize version_ failed", K(ret), KP(buf), K(data_len), K(pos));
+  } else if (OB_FAIL(serialization::decode_i32(buf, data_len, pos, &compressor_type_))) {
+    CLOG_LOG(WARN, "deserialize compressor_type_ failed", K(ret), KP(buf), K(data_len), K(pos));
+  } else if (OB_FAIL(serialization::decode_i64(buf, data_len, pos, &original_len_))) {
+    CLOG_LOG(WARN, "deserialize original_len_ failed", K(ret), KP(buf), K(data_len), K(pos));
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    CLOG_LOG(WARN, "invalid LogCompressedPayloadHeader", K(ret), KPC(this));
+  }
+  return ret;
+}
+
+DEFINE_GET_SERIALIZE_SIZE(LogCompressedPayloadHeader)
+{
+  int64_t size = 0;
+  size += serialization::encoded_length_i16(magic_);
+  size += serialization::encoded_length_i16(version_);
+  size += serialization::encoded_length_i32(compressor_type_);
+  size += serialization::encoded_length_i64(original_len_);
+  return size;
+}
+
+int decompress(const char *in_buf,
+               const int64_t in_buf_len,
+               char *out_buf,
+               const int64_t out_buf_len,
+               int64_t &decompressed_len)
+{
+  int ret = OB_SUCCESS;
+  LogCompressedPayloadHeader header;
+  ObCompressor *compressor = NULL;
+  int64_t pos = 0;
+  decompressed_len = 0;
+  if (OB_ISNULL(in_buf) || OB_ISNULL(out_buf) || in_buf_len <= 0 || out_buf_len <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    CLOG_LOG(WARN, "invalid argument", K(ret), KP(in_buf), K(in_buf_len), KP(out_buf), K(out_buf_len));
+  } else if (OB_FAIL(header.deserialize(in_buf, in_buf_len, pos))) {
+    CLOG_LOG(WARN, "failed to deserialize LogCompressedPayloadHeader", K(ret), K(in_buf_len));
+  } else if (OB_UNLIKELY(header.get_original_len() > out_buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    CLOG_LOG(WARN, "decompression buffer is not enough", K(ret), K(header), K(out_buf_len));
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(header.get_compressor_type(),
+                                                                     compressor))) {
+    CLOG_LOG(WARN, "failed to get compressor", K(ret), K(header));
+  } else if (OB_ISNULL(compressor)) {
+    ret = OB_ERR_UNEXPECTED;
+    CLOG_LOG(WARN, "compressor is NULL", K(ret), K(header));
+  } else if (OB_FAIL(compressor->decompress(in_buf + pos, in_buf_len - pos, out_buf,
+                                            out_buf_len, decompressed_len))) {
+    CLOG_LOG(WARN, "failed to decompress", K(ret), K(header), K(in_buf_len), K(out_buf_len));
+  } else if (OB_UNLIKELY(decompressed_len != header.get_original_len())) {
+    ret = OB_INVALID_DATA;
+    CLOG_LOG(ERROR, "decompressed length mismatch", K(ret), K(header), K(decompressed_len));
+  }
+  return ret;
+}
+
+ObLogCompressorWrapper::ObLogCompressorWrapper()
+  : is_inited_(false),
+    palf_id_(-1),
+    alloc_mgr_(NULL),
+    enable_compress_(false),
+    compressor_(NULL),
+    last_refresh_ts_(OB_INVALID_TIMESTAMP)
+{
+}
+
+ObLogCompressorWrapper::~ObLogCompressorWrapper()
+{
+  reset();
+}
+
+int ObLogCompressorWrapper::init(const int64_t palf_id, ObILogAllocator *alloc_mgr)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    CLOG_LOG(WARN, "ObLogCompressorWrapper init twice", K(ret), K(palf_id));
+  } else if (OB_ISNULL(alloc_mgr)) {
+    ret = OB_INVALID_ARGUMENT;
+    CLOG_LOG(WARN, "invalid argument", K(ret), K(palf_id), KP(alloc_mgr));
+  } else {
+    palf_id_ = palf_id;
+    alloc_mgr_ = alloc_mgr;
+    enable_compress_ = false;
+    compressor_ = NULL;
+    last_refresh_ts_ = OB_INVALID_TIMESTAMP;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObLogCompressorWrapper::reset()
+{
+  is_inited_ = false;
+  palf_id_ = -1;
+  alloc_mgr_ = NULL;
+  enable_compress_ = false;
+  compressor_ = NULL;
+  last_refresh_ts_ = OB_INVALID_TIMESTAMP;
+}
+
+void ObLogCompressorWrapper::refresh_config_if_needed_()
+{
+  const int64_t now = ObTimeUtility::fast_current_time();
+  const int64_t last_refresh_ts = ATOMIC_LOAD(&last_refresh_ts_);
+  // only one thread refreshes the config
+  if (now - last_refresh_ts >= REFRESH_CONFIG_INTERVAL
+      && ATOMIC_BCAS(&last_refresh_ts_, last_refresh_ts, now)) {
+    int ret = OB_SUCCESS;
+    uint64_t data_version = 0;
+    ObCompressor *compressor = NULL;
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    if (OB_FAIL(GET_MIN_DATA_VERSION(MTL_ID(), data_version))) {
+      CLOG_LOG(WARN, "failed to get min data version", K(ret), K_(palf_id));
+      ATOMIC_STORE(&enable_compress_, false);
+    } else if (data_version < MIN_COMPRESS_DATA_VERSION) {
+      // servers of older versions may still read the log
+      ATOMIC_STORE(&enable_compress_, false);
+    } else if (!tenant_config.is_valid()) {
+      // keep the previous config
+    } else if (!tenant_config->log_storage_compress_all) {
+      // disabled
+      ATOMIC_STORE(&enable_compress_, false);
+    } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(
+               tenant_config->log_storage_compress_func, compressor))) {
+      CLOG_LOG(WARN, "failed to get log storage compressor", K(ret), K_(palf_id));
+      ATOMIC_STORE(&enable_compress_, false);
+    } else if (OB_ISNULL(compressor) || NONE_COMPRESSOR == compressor->get_compressor_type()) {
+      ATOMIC_STORE(&enable_compress_, false);
+    } else {
+      ATOMIC_STORE(&compressor_, compressor);
+      ATOMIC_STORE(&enable_compress_, true);
+    }
+  }
+}
+
+int ObLogCompressorWrapper::compress_payload(const void *buffer,
+                                             const int64_t nbytes,
+                                             void *&compression_buf,
+                                             bool &compressed,
+                                             const void *&final_buf,
+                                             int64_t &final_nbytes)
+{
+  int ret = OB_SUCCESS;
+  compression_buf = NULL;
+  compressed = false;
+  final_buf = buffer;
+  final_nbytes = nbytes;
+  if (IS_NOT_INIT || OB_ISNULL(buffer) || nbytes < MIN_COMPRESS_PAYLOAD_SIZE) {
+    // do not compress
+  } else if (FALSE_IT(refresh_config_if_needed_())) {
+  } else if (!ATOMIC_LOAD(&enable_compress_)) {
+    // do not compress
+  } else {
+    ObCompressor *compressor = ATOMIC_LOAD(&compressor_);
+    const char *in_buf = static_cast<const char *>(buffer);
+    ObLogBaseHeader base_header;
+    int64_t header_pos = 0;
+    int64_t max_overflow_size = 0;
+    if (OB_ISNULL(compressor)) {
+      // do not compress
+    } else if (OB_FAIL(base_header.deserialize(in_buf, nbytes, header_pos))) {
+      CLOG_LOG(WARN, "failed to deserialize ObLogBaseHeader", K(ret), K_(palf_id), K(nbytes));
+    } else if (base_header.need_pre_replay_barrier() || base_header.is_compressed()) {
+      // the replay service reads the payload of pre barrier logs directly
+    } else if (OB_FAIL(compressor->get_max_overflow_size(nbytes - header_pos, max_overflow_size))) {
+      CLOG_LOG(WARN, "failed to get max overflow size", K(ret), K_(palf_id), K(nbytes));
+    } else {
+      const int64_t payload_len = nbytes - header_pos;
+      LogCompressedPayloadHeader comp_header(compressor->get_compressor_type(), payload_len);
+      const int64_t buf_len = header_pos + comp_header.get_serialize_size() + payload_len + max_overflow_size;
+      char *out_buf = NULL;
+      int64_t pos = 0;
+      int64_t compressed_len = 0;
+      base_header.set_compressed();
+      if (OB_ISNULL(out_buf = static_cast<char *>(alloc_mgr_->alloc_append_compression_buf(buf_len)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        if (REACH_TIME_INTERVAL(1 * 1000 * 1000)) {
+          CLOG_LOG(WARN, "failed to alloc compression buf", K(ret), K_(palf_id), K(buf_len));
+        }
+      } else if (FALSE_IT(compression_buf = out_buf)) {
+      } else if (OB_FAIL(base_header.serialize(out_buf, buf_len, pos))) {
+        CLOG_LOG(WARN, "failed to serialize ObLogBaseHeader", K(ret), K_(palf_id), K(base_header));
+      } else if (OB_FAIL(comp_header.serialize(out_buf, buf_len, pos))) {
+        CLOG_LOG(WARN, "failed to serialize LogCompressedPayloadHeader", K(ret), K_(palf_id), K(comp_header));
+      } else if (OB_FAIL(compressor->compress(in_buf + header_pos, payload_len, out_buf + pos,
+                                              buf_len - pos, compressed_len))) {
+        CLOG_LOG(WARN, "failed to compress log payload", K(ret), K_(palf_id), K(payload_len));
+      } else if (pos + compressed_len >= nbytes) {
+        // the compression ratio is too poor
+      } else {
+        compressed = true;
+        final_buf = out_buf;
+        final_nbytes = pos + compressed_len;
+      }
+      if (!compressed) {
+        free_compression_buf(compression_buf);
+      }
+    }
+  }
+  // the original log is appended if the compression fails
+  return OB_SUCCESS;
+}
+
+void ObLogCompressorWrapper::free_compression_buf(void *&compression_buf)
+{
+  if (NULL != compression_buf && NULL != alloc_mgr_) {
+    alloc_mgr_->free_append_compression_buf(compression_buf);
+  }
+  compression_buf = NULL;
+}
+
+} // namespace logservice
+} // namespace oceanbase
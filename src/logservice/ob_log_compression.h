@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifdef OB_BUILD_CLOSE_MODULES
+// the close modules provide their own log storage compression, which should not be shadowed by this one
+#include_next "logservice/ob_log_compression.h"
+#else
+#ifndef OCEANBASE_LOGSERVICE_OB_LOG_COMPRESSION_
+#define OCEANBASE_LOGSERVICE_OB_LOG_COMPRESSION_
+
+#include "lib/ob_define.h"
+#include "common/ob_version_def.h"
+#include "lib/compress/ob_compressor.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+class ObILogAllocator;
+}
+namespace logservice
+{
+// The layout of a compressed log:
+//
+// | ObLogBaseHeader(PAYLOAD_IS_COMPRESSED) | LogCompressedPayloadHeader | compressed payload |
+//
+// The base header is kept uncompressed, so that the replay barrier and the replay hint can be
+// read without decompressing the payload.
+class LogCompressedPayloadHeader
+{
+public:
+  LogCompressedPayloadHeader();
+  LogCompressedPayloadHeader(const common::ObCompressorType compressor_type,
+                             const int64_t original_len);
+  ~LogCompressedPayloadHeader() { reset(); }
+  void reset();
+  bool is_valid() const;
+  common::ObCompressorType get_compressor_type() const
+  { return static_cast<common::ObCompressorType>(compressor_type_); }
+  int64_t get_original_len() const { return original_len_; }
+  NEED_SERIALIZE_AND_DESERIALIZE;
+  TO_STRING_KV(K_(magic), K_(version), K_(compressor_type), K_(original_len));
+public:
+  static const int16_t MAGIC = 0x4C43; // 'LC'
+  static const int16_t VERSION = 1;
+private:
+  int16_t magic_;
+  int16_t version_;
+  int32_t compressor_type_;
+  int64_t original_len_;
+};
+
+// decompress the payload which starts with LogCompressedPayloadHeader
+int decompress(const char *in_buf,
+               const int64_t in_buf_len,
+               char *out_buf,
+               const int64_t out_buf_len,
+               int64_t &decompressed_len);
+
+// Compress the payload of logs before appending them to palf, it is controlled by the tenant
+// parameters log_storage_compress_all and log_storage_compress_func. Logs are never compressed
+// before the min data version of the tenant reaches MIN_COMPRESS_DATA_VERSION, because older
+// followers, archive and CDC can not decode LogCompressedPayloadHeader.
+//
+// NB: MIN_COMPRESS_DATA_VERSION is the current data version, which is shared with the 4.3.5
+// binaries built without log compression, so the data version does not tell whether every server
+// of the tenant can decode compressed logs. log_storage_compress_all is off by default and should
+// only be turned on after all servers, standby tenants, archive readers and CDC have been upgraded
+// to a build with log compression. It should be gated on a new data version once one is added.
+class ObLogCompressorWrapper
+{
+public:
+  ObLogCompressorWrapper();
+  ~ObLogCompressorWrapper();
+  int init(const int64_t palf_id, common::ObILogAllocator *alloc_mgr);
+  void reset();
+  bool is_valid() const { return is_inited_; }
+  // Compression is best effort, the original buffer is used when the log is too small, the
+  // compression ratio is poor or any error happens, so it always returns OB_SUCCESS.
+  //
+  // @param[in] buffer, the log which starts with ObLogBaseHeader.
+  // @param[in] nbytes, the size of the log.
+  // @param[out] compression_buf, the buffer allocated for the compressed log, it should be freed
+  //             by free_compression_buf() after the log has been appended.
+  // @param[out] compressed, whether final_buf is the compressed log.
+  // @param[out] final_buf, the log to be appended.
+  // @param[out] final_nbytes, the size of final_buf.
+  int compress_payload(const void *buffer,
+                       const int64_t nbytes,
+                       void *&compression_buf,
+                       bool &compressed,
+                       const void *&final_buf,
+                       int64_t &final_nbytes);
+  void free_compression_buf(void *&compression_buf);
+  TO_STRING_KV(K_(is_inited), K_(palf_id), K_(enable_compress), KP_(compressor), K_(last_refresh_ts));
+private:
+  void refresh_config_if_needed_();
+private:
+  // small logs such as commit info logs gain little from compression
+  static const int64_t MIN_COMPRESS_PAYLOAD_SIZE = 1024;
+  static const int64_t REFRESH_CONFIG_INTERVAL = 10 * 1000 * 1000L;
+  static const uint64_t MIN_COMPRESS_DATA_VERSION = DATA_VERSION_4_3_5_0;
+  bool is_inited_;
+  int64_t palf_id_;
+  common::ObILogAllocator *alloc_mgr_;
+  bool enable_compress_;
+  common::ObCompressor *compressor_;
+  int64_t last_refresh_ts_;
+  DISALLOW_COPY_AND_ASSIGN(ObLogCompressorWrapper);
+};
+
+} // namespace logservice
+} // namespace oceanbase
+
+#endif
+#endif // OB_BUILD_CLOSE_MODULES
@@ -75,6 +75,13 @@ constexpr int64_t CLOG_FILE_TAIL_PADDING_TRIGGER = 4096;     // 文件尾剩余
 // So the MAX_LOG_BUFFER_SIZE is defined as below:
 constexpr offset_t MAX_LOG_BUFFER_SIZE = MAX_LOG_BODY_SIZE + MAX_LOG_HEADER_SIZE + CLOG_FILE_TAIL_PADDING_TRIGGER;        // max size of the log buffer is (3.5MB + 4KB + 4KB)
 
+// When LogIteratorImpl keeps consuming logs sequentially (i.e. catching up from disk), the size of
+// each round of pread is doubled until MAX_LOG_READ_AHEAD_SIZE, a larger O_DIRECT read will be
+// split by the kernel into concurrent requests, so that reading is not bound to the latency of disk.
+// The read buffer enlarged by the read window is given back once the iterator catches up with the
+// end of log, see need_shrink_read_buf().
+constexpr offset_t MAX_LOG_READ_AHEAD_SIZE = 4 * MAX_LOG_BUFFER_SIZE;
+
 constexpr offset_t LOG_DIO_ALIGN_SIZE = 4 * 1024;
 constexpr offset_t LOG_DIO_ALIGNED_BUF_SIZE_REDO = MAX_LOG_BUFFER_SIZE + LOG_DIO_ALIGN_SIZE;
 constexpr offset_t LOG_DIO_ALIGNED_BUF_SIZE_META = MAX_META_ENTRY_SIZE + LOG_DIO_ALIGN_SIZE;
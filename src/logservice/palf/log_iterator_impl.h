@@ -1001,8 +1001,12 @@ int LogIteratorImpl<ENTRY>::read_data_from_storage_(LogIOContext &io_ctx)
     PALF_LOG(WARN, "IteratorStorage pread failed", K(ret), KPC(this));
   } else if (OB_ERR_OUT_OF_UPPER_BOUND == ret) {
     ret = OB_ITER_END;
+    // has caught up with the end of log, shrink the read window, IteratorStorage gives back the
+    // enlarged read buffer in next round of pread.
+    next_round_pread_size_ = MAX_LOG_BUFFER_SIZE;
     PALF_LOG(TRACE, "IteratorStorage pread failed", K(ret), KPC(this));
   } else {
+    next_round_pread_size_ = calc_next_round_pread_size(next_round_pread_size_, out_read_size);
     curr_read_buf_start_pos_ = 0;
     curr_read_pos_ = 0;
     curr_read_buf_end_pos_ = out_read_size;
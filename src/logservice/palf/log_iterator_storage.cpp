@@ -103,7 +103,7 @@ int IteratorStorage::pread(
   } else if (0 == real_in_read_size) {
     ret = OB_ITER_END;
     PALF_LOG(WARN, "IteratorStorage has iterate end", K(ret), KPC(this));
-  } else if (OB_FAIL(read_data_from_storage_(real_pos, real_in_read_size, buf, out_read_size, io_ctx))) {
+  } else if (OB_FAIL(read_data_from_storage_(real_pos, real_in_read_size, in_read_size, buf, out_read_size, io_ctx))) {
     PALF_LOG(WARN, "read_data_from_storage_ failed", K(ret), K(pos), K(in_read_size), KP(buf), KPC(this));
   } else {
     start_lsn_ = start_lsn_ + real_pos;
@@ -117,14 +117,16 @@ int IteratorStorage::pread(
 int IteratorStorage::read_data_from_storage_(
     int64_t &pos,
     const int64_t in_read_size,
+    const int64_t window_size,
     char *&buf,
     int64_t &out_read_size,
     LogIOContext &io_ctx)
 {
   int ret = OB_SUCCESS;
   int64_t remain_valid_data_size = 0;
-  if (OB_FAIL(ensure_memory_layout_correct_(pos, in_read_size, remain_valid_data_size))) {
-    PALF_LOG(WARN, "ensure_memory_layout_correct_ failed", K(ret), K(pos), K(in_read_size), KPC(this));
+  if (OB_FAIL(ensure_memory_layout_correct_(pos, in_read_size, window_size, remain_valid_data_size))) {
+    PALF_LOG(WARN, "ensure_memory_layout_correct_ failed", K(ret), K(pos), K(in_read_size),
+        K(window_size), KPC(this));
   } else {
     // avoid read repeated data from disk
     const LSN curr_round_read_lsn = start_lsn_ + pos + remain_valid_data_size;
@@ -153,6 +155,7 @@ int IteratorStorage::read_data_from_storage_(
 int IteratorStorage::ensure_memory_layout_correct_(
     const int64_t pos,
     const int64_t in_read_size,
+    const int64_t window_size,
     int64_t &remain_valid_data_size)
 {
   int ret = OB_SUCCESS;
@@ -165,6 +168,14 @@ int IteratorStorage::ensure_memory_layout_correct_(
     if (in_read_size > max_valid_buf_len) {
       ret = alloc_read_buf("IteratorStorage", in_read_size, tmp_read_buf);
       PALF_LOG(TRACE, "need alloc read buf", K(ret), KPC(this), K(tmp_read_buf));
+    } else if (need_shrink_read_buf(read_buf_, window_size)) {
+      // the read window has been reset, give back the memory used by read ahead. It's fine to
+      // keep the larger buffer if the allocation fails. The window size is checked instead of
+      // 'in_read_size', which is clamped at the end of file while the window is still enlarged.
+      if (OB_SUCCESS != alloc_read_buf("IteratorStorage", MAX_LOG_BUFFER_SIZE, tmp_read_buf)) {
+        tmp_read_buf = read_buf_;
+      }
+      PALF_LOG(TRACE, "shrink read buf", K(ret), KPC(this), K(tmp_read_buf));
     }
     if (OB_SUCC(ret)) {
       PALF_LOG(TRACE, "before ensure_memory_layout_correct_", KPC(this), K(in_read_size), K(remain_valid_data_size));
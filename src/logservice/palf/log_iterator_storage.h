@@ -50,15 +50,19 @@ public:
   TO_STRING_KV(K_(start_lsn), K_(end_lsn), K_(read_buf), K_(block_size), KP(log_storage_), KPC(log_storage_),
                "storage_type", (NULL == log_storage_ ? "dummy" : log_storage_->get_log_storage_type_str()));
 private:
+  // 'window_size' is the read size asked by the caller, 'in_read_size' may be less than it
+  // at the end of file.
   int read_data_from_storage_(
       int64_t &pos,
       const int64_t in_read_size,
+      const int64_t window_size,
       char *&buf,
       int64_t &out_read_size,
       LogIOContext &io_ctx);
 
   int ensure_memory_layout_correct_(const int64_t pos,
                                     const int64_t in_read_size,
+                                    const int64_t window_size,
                                     int64_t &remain_valid_data_size);
   void do_memove_(ReadBuf &dst,
                   const int64_t pos,
@@ -91,7 +91,7 @@ int LogReader::pread(const block_id_t block_id,
     const int64_t start_ts = ObTimeUtility::fast_current_time();
     int64_t remained_read_size = in_read_size;
     int64_t remained_read_buf_len = read_buf.buf_len_;
-    int64_t step = MAX_LOG_BUFFER_SIZE;
+    int64_t step = MAX_LOG_READ_AHEAD_SIZE;
     while (remained_read_size > 0 && OB_SUCC(ret)) {
       const int64_t curr_in_read_size = MIN(step, remained_read_size);
       char *curr_read_buf = read_buf.buf_ + in_read_size - remained_read_size;
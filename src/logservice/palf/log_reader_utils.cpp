@@ -121,5 +121,24 @@ bool is_valid_raw_read_buf(const ReadBuf &raw_read_buf,
   return bool_ret;
 }
 
+int64_t calc_next_round_pread_size(const int64_t curr_pread_size, const int64_t out_read_size)
+{
+  int64_t next_pread_size = curr_pread_size;
+  // the whole read window has been filled, the logs are consumed sequentially, double the read
+  // window for next round to reduce the number of synchronous disk reads.
+  if (out_read_size >= curr_pread_size) {
+    next_pread_size = MIN(curr_pread_size * 2, MAX_LOG_READ_AHEAD_SIZE);
+  }
+  return next_pread_size;
+}
+
+bool need_shrink_read_buf(const ReadBuf &read_buf, const int64_t read_window_size)
+{
+  const int64_t max_valid_buf_len = read_buf.buf_len_ - LOG_DIO_ALIGN_SIZE - LOG_CACHE_ALIGN_SIZE;
+  return read_buf.is_valid()
+      && read_window_size <= MAX_LOG_BUFFER_SIZE
+      && max_valid_buf_len > upper_align(MAX_LOG_BUFFER_SIZE, LOG_DIO_ALIGN_SIZE);
+}
+
 } // end of logservice
 } // end of oceanbase
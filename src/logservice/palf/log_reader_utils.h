@@ -51,6 +51,16 @@ bool is_valid_raw_read_buf(const ReadBuf &raw_read_buf,
                            const int64_t offset,
                            const int64_t nbytes);
 
+// LogIteratorImpl doubles its read window each time a round of pread fills the whole window,
+// until MAX_LOG_READ_AHEAD_SIZE.
+int64_t calc_next_round_pread_size(const int64_t curr_pread_size, const int64_t out_read_size);
+
+// The read buffer of IteratorStorage grows with the read window of LogIteratorImpl. Once the
+// window is reset to MAX_LOG_BUFFER_SIZE, the buffer should be shrunk too, otherwise a long-lived
+// iterator holds the memory of its largest read window for its whole lifetime.
+// 'read_window_size' is the read size asked by LogIteratorImpl, not clamped by the end of file.
+bool need_shrink_read_buf(const ReadBuf &read_buf, const int64_t read_window_size);
+
 } // end of logservice
 } // end of oceanbase
 
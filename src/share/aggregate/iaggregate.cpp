@@ -44,6 +44,8 @@ extern int init_approx_count_distinct_synopsis_aggregate(RuntimeContext &agg_ctx
                                                          ObIAllocator &allocator, IAggregate *&agg);
 extern int init_sysbit_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
                                  ObIAllocator &allocator, IAggregate *&agg);
+extern int init_rb_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                             ObIAllocator &allocator, IAggregate *&agg);
 #define INIT_AGGREGATE_CASE(OP_TYPE, func_name, col_id)                                            \
   case (OP_TYPE): {                                                                                \
     ret = init_##func_name##_aggregate(agg_ctx, col_id, allocator, aggregate);                     \
@@ -82,6 +84,9 @@ int init_aggregates(RuntimeContext &agg_ctx, ObIAllocator &allocator,
         INIT_AGGREGATE_CASE(T_FUN_SYS_BIT_OR, sysbit, i);
         INIT_AGGREGATE_CASE(T_FUN_SYS_BIT_AND, sysbit, i);
         INIT_AGGREGATE_CASE(T_FUN_SYS_BIT_XOR, sysbit, i);
+        INIT_AGGREGATE_CASE(T_FUN_SYS_RB_BUILD_AGG, rb, i);
+        INIT_AGGREGATE_CASE(T_FUN_SYS_RB_OR_AGG, rb, i);
+        INIT_AGGREGATE_CASE(T_FUN_SYS_RB_AND_AGG, rb, i);
       default: {
         ret = OB_NOT_SUPPORTED;
         SQL_LOG(WARN, "not supported aggregate function", K(ret), K(aggr_info.expr_->type_));
@@ -129,6 +134,10 @@ static int32_t agg_cell_tmp_res_size(RuntimeContext &agg_ctx, int64_t agg_col_id
     }
   } else if (info.get_expr_type() == T_FUN_APPROX_COUNT_DISTINCT) {
     ret_size = sizeof(char *);
+  } else if (info.get_expr_type() == T_FUN_SYS_RB_BUILD_AGG
+             || info.get_expr_type() == T_FUN_SYS_RB_OR_AGG
+             || info.get_expr_type() == T_FUN_SYS_RB_AND_AGG) {
+    ret_size = sizeof(char *); // address of in-memory roaringbitmap
   }
   return ret_size;
 }
@@ -185,10 +185,29 @@ public:
       OB_ASSERT(agg_expr != NULL);
       // TODO: remove distinct constraint @zongmei.zzm
       supported = aggregate::supported_aggregate_function(agg_expr->get_expr_type());
+      if (supported && is_rb_aggregate(agg_expr->get_expr_type())) {
+        // other param types are rejected or casted by the row based aggregate
+        const ObRawExpr *param_expr = agg_expr->get_param_expr(0);
+        if (OB_ISNULL(param_expr)) {
+          supported = false;
+        } else if (agg_expr->get_expr_type() == T_FUN_SYS_RB_BUILD_AGG) {
+          supported = ob_is_int_tc(param_expr->get_data_type())
+                      || ob_is_uint_tc(param_expr->get_data_type());
+        } else {
+          supported = ob_is_roaringbitmap(param_expr->get_data_type())
+                      || param_expr->get_data_type() == ObHexStringType;
+        }
+      }
     }
     return supported;
   }
 
+  inline static bool is_rb_aggregate(const ObExprOperatorType agg_type)
+  {
+    return T_FUN_SYS_RB_BUILD_AGG == agg_type || T_FUN_SYS_RB_OR_AGG == agg_type
+           || T_FUN_SYS_RB_AND_AGG == agg_type;
+  }
+
   inline int64_t aggregates_cnt() const
   {
     return agg_ctx_.aggr_infos_.count();
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "rb_agg.h"
+
+namespace oceanbase
+{
+namespace share
+{
+namespace aggregate
+{
+namespace helper
+{
+int init_rb_aggregate(RuntimeContext &agg_ctx, const int64_t agg_col_id,
+                      ObIAllocator &allocator, IAggregate *&agg)
+{
+#define INIT_RB_AGG(op_type, vec_tc)                                                               \
+  do {                                                                                             \
+    ret = init_agg_func<RbAggregate<op_type, vec_tc, VEC_TC_ROARINGBITMAP>>(                       \
+      agg_ctx, agg_col_id, has_distinct, allocator, agg);                                          \
+  } while (false)
+
+  int ret = OB_SUCCESS;
+  ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+  bool has_distinct = aggr_info.has_distinct_;
+  if (OB_UNLIKELY(aggr_info.param_exprs_.count() != 1)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected param exprs", K(ret), K(aggr_info));
+  } else if (OB_UNLIKELY(aggr_info.expr_->get_vec_value_tc() != VEC_TC_ROARINGBITMAP)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected result expr", K(ret), K(aggr_info));
+  } else {
+    VecValueTypeClass in_tc = aggr_info.param_exprs_.at(0)->get_vec_value_tc();
+    ObExprOperatorType fn_type = aggr_info.get_expr_type();
+    if (fn_type == T_FUN_SYS_RB_BUILD_AGG) {
+      if (in_tc == VEC_TC_INTEGER) {
+        INIT_RB_AGG(T_FUN_SYS_RB_BUILD_AGG, VEC_TC_INTEGER);
+      } else if (in_tc == VEC_TC_UINTEGER) {
+        INIT_RB_AGG(T_FUN_SYS_RB_BUILD_AGG, VEC_TC_UINTEGER);
+      } else {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected param type", K(ret), K(in_tc));
+      }
+    } else if (fn_type == T_FUN_SYS_RB_OR_AGG || fn_type == T_FUN_SYS_RB_AND_AGG) {
+      if (in_tc != VEC_TC_ROARINGBITMAP && in_tc != VEC_TC_STRING) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected param type", K(ret), K(in_tc));
+      } else if (fn_type == T_FUN_SYS_RB_OR_AGG) {
+        if (in_tc == VEC_TC_ROARINGBITMAP) {
+          INIT_RB_AGG(T_FUN_SYS_RB_OR_AGG, VEC_TC_ROARINGBITMAP);
+        } else {
+          INIT_RB_AGG(T_FUN_SYS_RB_OR_AGG, VEC_TC_STRING);
+        }
+      } else {
+        if (in_tc == VEC_TC_ROARINGBITMAP) {
+          INIT_RB_AGG(T_FUN_SYS_RB_AND_AGG, VEC_TC_ROARINGBITMAP);
+        } else {
+          INIT_RB_AGG(T_FUN_SYS_RB_AND_AGG, VEC_TC_STRING);
+        }
+      }
+    } else {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected roaringbitmap aggregate", K(ret), K(fn_type));
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("init roaringbitmap aggregate failed", K(ret));
+    }
+  }
+  return ret;
+#undef INIT_RB_AGG
+}
+}
+} // end aggregate
+} // end share
+} // end oceanbase
@@ -0,0 +1,497 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SHARE_AGGREGATE_RB_AGG_H_
+#define OCEANBASE_SHARE_AGGREGATE_RB_AGG_H_
+
+#include "share/aggregate/iaggregate.h"
+#include "lib/roaringbitmap/ob_roaringbitmap.h"
+#include "lib/roaringbitmap/ob_rb_utils.h"
+#include "lib/alloc/malloc_hook.h"
+#include "sql/engine/expr/ob_expr_lob_utils.h"
+#include "sql/engine/expr/ob_expr_rb_func_helper.h"
+
+namespace oceanbase
+{
+namespace share
+{
+namespace aggregate
+{
+// rb_build_agg/rb_or_agg/rb_and_agg
+//
+// Each group keeps a live roaringbitmap, its address is stored in the tmp result following the
+// <char *, int32_t> result cell. Inputs are merged into the bitmap in place and the bitmap is
+// serialized only once when the group result is collected. The serialized result is kept in the
+// result cell and the bitmap is recycled, a group is rebuilt from the result cell if it is
+// accessed again.
+//
+// Memory: the live bitmaps are allocated by croaring through ObRbMemMgr of the tenant, which is
+// not charged to agg_ctx.allocator_ and the SQL work area. At most MAX_LIVE_BITMAP_CNT of them are
+// kept per aggregate, once it is exceeded all the live bitmaps are serialized into their result
+// cells in agg_ctx.allocator_, where hash group by sees them when deciding to dump. The worst case
+// for many groups is one deserialization and serialization per input row, as the row based
+// aggregate does.
+template <ObExprOperatorType agg_func, VecValueTypeClass in_tc, VecValueTypeClass out_tc>
+class RbAggregate final
+  : public BatchAggregateWrapper<RbAggregate<agg_func, in_tc, out_tc>>
+{
+  static const constexpr int32_t RES_CELL_SIZE = sizeof(char *) + sizeof(int32_t);
+  static const constexpr int64_t MAX_LIVE_BITMAP_CNT = 1024;
+  struct BitmapNode
+  {
+    explicit BitmapNode(ObIAllocator *allocator) :
+      rb_(allocator), agg_cell_(nullptr), next_(nullptr), free_next_(nullptr)
+    {}
+    ObRoaringBitmap rb_;
+    // the aggregate cell which the bitmap belongs to, nullptr if the node is free
+    char *agg_cell_;
+    // all nodes allocated, used to release croaring memory in reuse/destroy
+    BitmapNode *next_;
+    BitmapNode *free_next_;
+  };
+public:
+  static const constexpr VecValueTypeClass IN_TC = in_tc;
+  static const constexpr VecValueTypeClass OUT_TC = out_tc;
+public:
+  RbAggregate() :
+    rb_allocator_(), mem_attr_(), all_nodes_(nullptr), free_nodes_(nullptr), live_cnt_(0),
+    batch_vals_(nullptr), batch_cnt_(0), batch_cap_(0), param_type_(ObNullType),
+    has_lob_header_(false)
+  {}
+
+  int init(RuntimeContext &agg_ctx, const int64_t agg_col_id, ObIAllocator &allocator) override
+  {
+    int ret = OB_SUCCESS;
+    ObAggrInfo &aggr_info = agg_ctx.locate_aggr_info(agg_col_id);
+    mem_attr_ = ObMemAttr(
+      sql::ObRbExprHelper::get_tenant_id(agg_ctx.eval_ctx_.exec_ctx_.get_my_session()),
+      "ROARINGBITMAP");
+    rb_allocator_.set_attr(mem_attr_);
+    if (OB_UNLIKELY(aggr_info.param_exprs_.count() != 1)) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_LOG(WARN, "unexpected param exprs", K(ret), K(aggr_info));
+    } else {
+      param_type_ = aggr_info.param_exprs_.at(0)->datum_meta_.type_;
+      has_lob_header_ = aggr_info.param_exprs_.at(0)->obj_meta_.has_lob_header();
+    }
+    if (OB_SUCC(ret) && agg_func == T_FUN_SYS_RB_BUILD_AGG) {
+      batch_cap_ = std::max(agg_ctx.eval_ctx_.max_batch_size_, 1L);
+      if (OB_ISNULL(batch_vals_ = (uint64_t *)allocator.alloc(sizeof(uint64_t) * batch_cap_))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        SQL_LOG(WARN, "allocate memory failed", K(ret), K(batch_cap_));
+      }
+    }
+    return ret;
+  }
+
+  void reuse() override
+  {
+    release_all_bitmaps();
+    rb_allocator_.reset_remain_one_page();
+  }
+
+  void destroy() override
+  {
+    release_all_bitmaps();
+    rb_allocator_.reset();
+    batch_vals_ = nullptr;
+    batch_cnt_ = 0;
+    batch_cap_ = 0;
+  }
+
+  template <typename ColumnFmt>
+  OB_INLINE int add_row(RuntimeContext &agg_ctx, ColumnFmt &columns, const int32_t row_num,
+                        const int32_t agg_col_id, char *agg_cell, void *tmp_res, int64_t &calc_info)
+  {
+    int ret = OB_SUCCESS;
+    UNUSED(calc_info);
+    const char *payload = nullptr;
+    int32_t len = 0;
+    columns.get_payload(row_num, payload, len);
+    if (OB_ISNULL(tmp_res)) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_LOG(WARN, "invalid null roaringbitmap", K(ret));
+    } else if (agg_func == T_FUN_SYS_RB_BUILD_AGG) {
+      // values of one batch are staged and added to the bitmap in bulk by `collect_tmp_result`
+      uint64_t val = 0;
+      if (OB_FAIL(get_uint64_value(payload, val))) {
+        SQL_LOG(WARN, "get value failed", K(ret));
+      } else if (batch_cnt_ >= batch_cap_
+                 && OB_FAIL(flush_batch_vals(*static_cast<ObRoaringBitmap *>(tmp_res)))) {
+        SQL_LOG(WARN, "flush batch values failed", K(ret));
+      } else {
+        batch_vals_[batch_cnt_++] = val;
+        agg_ctx.locate_notnulls_bitmap(agg_col_id, agg_cell).set(agg_col_id);
+      }
+    } else if (OB_FAIL(merge_binary(agg_ctx, payload, len, agg_col_id, agg_cell,
+                                    *static_cast<ObRoaringBitmap *>(tmp_res)))) {
+      SQL_LOG(WARN, "merge roaringbitmap failed", K(ret));
+    }
+    return ret;
+  }
+
+  template <typename ColumnFmt>
+  OB_INLINE int add_nullable_row(RuntimeContext &agg_ctx, ColumnFmt &columns, const int32_t row_num,
+                                 const int32_t agg_col_id, char *agg_cell, void *tmp_res,
+                                 int64_t &calc_info)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_UNLIKELY(columns.is_null(row_num))) {
+      SQL_LOG(DEBUG, "add null row", K(ret), K(row_num));
+    } else if (OB_FAIL(
+                 add_row(agg_ctx, columns, row_num, agg_col_id, agg_cell, tmp_res, calc_info))) {
+      SQL_LOG(WARN, "add row failed", K(ret));
+    }
+    return ret;
+  }
+
+  int collect_tmp_result(RuntimeContext &agg_ctx, const int32_t agg_col_id, char *agg_cell)
+  {
+    int ret = OB_SUCCESS;
+    if (agg_func == T_FUN_SYS_RB_BUILD_AGG && batch_cnt_ > 0) {
+      ObRoaringBitmap *rb = static_cast<ObRoaringBitmap *>(get_tmp_res(agg_ctx, agg_col_id, agg_cell));
+      if (OB_ISNULL(rb)) {
+        ret = OB_ERR_UNEXPECTED;
+        SQL_LOG(WARN, "invalid null roaringbitmap", K(ret));
+      } else if (OB_FAIL(flush_batch_vals(*rb))) {
+        SQL_LOG(WARN, "flush batch values failed", K(ret));
+      }
+    }
+    batch_cnt_ = 0;
+    if (OB_SUCC(ret) && OB_FAIL(spill_bitmaps_if_needed(agg_ctx))) {
+      SQL_LOG(WARN, "spill roaringbitmaps failed", K(ret));
+    }
+    return ret;
+  }
+
+  int add_one_row(RuntimeContext &agg_ctx, int64_t batch_idx, int64_t batch_size,
+                  const bool is_null, const char *data, const int32_t data_len, int32_t agg_col_idx,
+                  char *agg_cell) override
+  {
+    int ret = OB_SUCCESS;
+    UNUSEDx(batch_idx, batch_size);
+    ObRoaringBitmap *rb = nullptr;
+    if (is_null) {
+      // do nothing
+    } else if (OB_ISNULL(rb = static_cast<ObRoaringBitmap *>(get_tmp_res(agg_ctx, agg_col_idx, agg_cell)))) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_LOG(WARN, "invalid null roaringbitmap", K(ret));
+    } else if (agg_func == T_FUN_SYS_RB_BUILD_AGG) {
+      uint64_t val = 0;
+      lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+      if (OB_FAIL(get_uint64_value(data, val))) {
+        SQL_LOG(WARN, "get value failed", K(ret));
+      } else if (OB_FAIL(rb->value_add(val))) {
+        SQL_LOG(WARN, "failed to add value to roaringbitmap", K(ret), K(val));
+      } else {
+        agg_ctx.locate_notnulls_bitmap(agg_col_idx, agg_cell).set(agg_col_idx);
+      }
+    } else if (OB_FAIL(merge_binary(agg_ctx, data, data_len, agg_col_idx, agg_cell, *rb))) {
+      SQL_LOG(WARN, "merge roaringbitmap failed", K(ret));
+    }
+    if (OB_SUCC(ret) && OB_FAIL(spill_bitmaps_if_needed(agg_ctx))) {
+      SQL_LOG(WARN, "spill roaringbitmaps failed", K(ret));
+    }
+    return ret;
+  }
+
+  template <typename ColumnFmt>
+  int collect_group_result(RuntimeContext &agg_ctx, const sql::ObExpr &agg_expr,
+                           const int32_t agg_col_id, const char *agg_cell,
+                           const int32_t agg_cell_len)
+  {
+    int ret = OB_SUCCESS;
+    const NotNullBitVector &not_nulls = agg_ctx.locate_notnulls_bitmap(agg_col_id, agg_cell);
+    int64_t output_idx = agg_ctx.eval_ctx_.get_batch_idx();
+    ColumnFmt *res_vec = static_cast<ColumnFmt *>(agg_expr.get_vector(agg_ctx.eval_ctx_));
+    char *cell = const_cast<char *>(agg_cell);
+    BitmapNode *node = reinterpret_cast<BitmapNode *>(EXTRACT_MEM_ADDR(cell + RES_CELL_SIZE));
+    if (!not_nulls.at(agg_col_id)) {
+      res_vec->set_null(output_idx);
+    } else if (OB_NOT_NULL(node) && OB_FAIL(store_result(agg_ctx, cell, node))) {
+      SQL_LOG(WARN, "store roaringbitmap result failed", K(ret));
+    } else {
+      const char *rb_bin = EXTRACT_MEM_ADDR(cell);
+      int32_t rb_bin_len = *reinterpret_cast<const int32_t *>(cell + sizeof(char *));
+      sql::ObTextStringVectorResult<ColumnFmt> blob_res(agg_expr.datum_meta_.type_, &agg_expr,
+                                                        &agg_ctx.eval_ctx_, res_vec, output_idx);
+      if (OB_FAIL(blob_res.init_with_batch_idx(rb_bin_len, output_idx))) {
+        SQL_LOG(WARN, "failed to init blob res", K(ret), K(rb_bin_len));
+      } else if (OB_FAIL(blob_res.append(rb_bin, rb_bin_len))) {
+        SQL_LOG(WARN, "failed to append roaringbitmap binary data", K(ret), K(rb_bin_len));
+      } else {
+        blob_res.set_result();
+      }
+    }
+    return ret;
+  }
+
+  virtual int rollup_aggregation(RuntimeContext &agg_ctx, const int32_t agg_col_idx,
+                                 AggrRowPtr group_row, AggrRowPtr rollup_row,
+                                 int64_t cur_rollup_group_idx,
+                                 int64_t max_group_cnt = INT64_MIN) override
+  {
+    int ret = OB_SUCCESS;
+    UNUSEDx(cur_rollup_group_idx, max_group_cnt);
+    char *curr_agg_cell = agg_ctx.row_meta().locate_cell_payload(agg_col_idx, group_row);
+    char *rollup_agg_cell = agg_ctx.row_meta().locate_cell_payload(agg_col_idx, rollup_row);
+    const NotNullBitVector &curr_not_nulls = agg_ctx.locate_notnulls_bitmap(agg_col_idx, curr_agg_cell);
+    NotNullBitVector &rollup_not_nulls = agg_ctx.locate_notnulls_bitmap(agg_col_idx, rollup_agg_cell);
+    ObRoaringBitmap *curr_rb = nullptr;
+    ObRoaringBitmap *rollup_rb = nullptr;
+    if (!curr_not_nulls.at(agg_col_idx)) {
+      // do nothing
+    } else if (OB_ISNULL(curr_rb = static_cast<ObRoaringBitmap *>(
+                           get_tmp_res(agg_ctx, agg_col_idx, curr_agg_cell)))
+               || OB_ISNULL(rollup_rb = static_cast<ObRoaringBitmap *>(
+                              get_tmp_res(agg_ctx, agg_col_idx, rollup_agg_cell)))) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_LOG(WARN, "invalid null roaringbitmap", K(ret), KP(curr_rb), KP(rollup_rb));
+    } else {
+      lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+      if (agg_func == T_FUN_SYS_RB_AND_AGG && rollup_not_nulls.at(agg_col_idx)) {
+        ret = rollup_rb->value_and(curr_rb);
+      } else {
+        ret = rollup_rb->value_or(curr_rb);
+      }
+      if (OB_FAIL(ret)) {
+        SQL_LOG(WARN, "rollup roaringbitmap failed", K(ret));
+      } else {
+        rollup_not_nulls.set(agg_col_idx);
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(spill_bitmaps_if_needed(agg_ctx))) {
+      SQL_LOG(WARN, "spill roaringbitmaps failed", K(ret));
+    }
+    return ret;
+  }
+
+  inline void *get_tmp_res(RuntimeContext &agg_ctx, int32_t agg_col_id, char *agg_cell) override
+  {
+    int ret = OB_SUCCESS;
+    void *ret_ptr = nullptr;
+    BitmapNode *node = reinterpret_cast<BitmapNode *>(EXTRACT_MEM_ADDR(agg_cell + RES_CELL_SIZE));
+    if (OB_ISNULL(node)) {
+      int32_t rb_bin_len = *reinterpret_cast<const int32_t *>(agg_cell + sizeof(char *));
+      if (OB_FAIL(alloc_node(node))) {
+        SQL_LOG(ERROR, "allocate roaringbitmap failed", K(ret));
+      } else if (rb_bin_len > 0) {
+        // result has been collected before, rebuild the bitmap from it
+        lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+        if (OB_FAIL(node->rb_.deserialize(ObString(rb_bin_len, EXTRACT_MEM_ADDR(agg_cell))))) {
+          SQL_LOG(ERROR, "failed to deserialize roaringbitmap", K(ret));
+          free_node(node);
+          node = nullptr;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        node->agg_cell_ = agg_cell;
+        STORE_MEM_ADDR(node, (agg_cell + RES_CELL_SIZE));
+      }
+    }
+    if (OB_NOT_NULL(node)) {
+      ret_ptr = &node->rb_;
+    }
+    return ret_ptr;
+  }
+
+  TO_STRING_KV("aggregate", "roaringbitmap", K(in_tc), K(out_tc), K(agg_func), K_(live_cnt),
+               K_(batch_cnt), K_(batch_cap));
+
+private:
+  OB_INLINE int get_uint64_value(const char *payload, uint64_t &val)
+  {
+    int ret = OB_SUCCESS;
+    if (in_tc == VEC_TC_UINTEGER) {
+      val = *reinterpret_cast<const uint64_t *>(payload);
+    } else {
+      int64_t val_64 = *reinterpret_cast<const int64_t *>(payload);
+      if (OB_UNLIKELY(val_64 < INT32_MIN)) {
+        ret = OB_SIZE_OVERFLOW;
+        SQL_LOG(WARN, "negative integer not in the range of int32", K(ret), K(val_64));
+      } else if (val_64 < 0) {
+        // convert negative integer to uint32
+        val = static_cast<uint64_t>(static_cast<uint32_t>(val_64));
+      } else {
+        val = static_cast<uint64_t>(val_64);
+      }
+    }
+    return ret;
+  }
+
+  int flush_batch_vals(ObRoaringBitmap &rb)
+  {
+    int ret = OB_SUCCESS;
+    lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+    if (OB_FAIL(rb.value_add_batch(batch_vals_, batch_cnt_))) {
+      SQL_LOG(WARN, "failed to add values to roaringbitmap", K(ret), K(batch_cnt_));
+    } else {
+      batch_cnt_ = 0;
+    }
+    return ret;
+  }
+
+  // deserialize one input and merge it into the group bitmap in place
+  int merge_binary(RuntimeContext &agg_ctx, const char *data, const int32_t data_len,
+                   const int32_t agg_col_id, char *agg_cell, ObRoaringBitmap &rb)
+  {
+    int ret = OB_SUCCESS;
+    NotNullBitVector &not_nulls = agg_ctx.locate_notnulls_bitmap(agg_col_id, agg_cell);
+    bool is_first = !not_nulls.at(agg_col_id);
+    if (agg_func == T_FUN_SYS_RB_AND_AGG && !is_first && rb.get_cardinality() == 0) {
+      // result of rb_and_agg is always empty, skip deserialization
+    } else {
+      ObEvalCtx::TempAllocGuard alloc_guard(agg_ctx.eval_ctx_);
+      ObIAllocator &tmp_alloc = alloc_guard.get_allocator();
+      lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+      ObString rb_bin(data_len, data);
+      ObRoaringBitmap *input_rb = nullptr;
+      if (ObRoaringBitmapType == param_type_) {
+        if (OB_FAIL(sql::ObTextStringHelper::read_real_string_data(
+              &tmp_alloc, param_type_, has_lob_header_, rb_bin, &agg_ctx.eval_ctx_.exec_ctx_))) {
+          SQL_LOG(WARN, "failed to get real data", K(ret), K(rb_bin));
+        } else if (OB_FAIL(ObRbUtils::rb_deserialize(tmp_alloc, rb_bin, input_rb))) {
+          SQL_LOG(WARN, "failed to deserialize roaringbitmap", K(ret));
+        }
+      } else if (ObHexStringType == param_type_) {
+        bool need_validate = true;
+        if (OB_FAIL(ObRbUtils::check_binary(rb_bin))) {
+          SQL_LOG(WARN, "invalid roaringbitmap binary string", K(ret));
+        } else if (OB_FAIL(ObRbUtils::rb_deserialize(tmp_alloc, rb_bin, input_rb, need_validate))) {
+          SQL_LOG(WARN, "failed to deserialize roaringbitmap", K(ret));
+        }
+      } else {
+        ret = OB_ERR_INVALID_TYPE_FOR_ARGUMENT;
+        SQL_LOG(WARN, "invalid data type for roaringbitmap agg", K(ret), K(param_type_));
+      }
+      if (OB_FAIL(ret)) {
+      } else if (agg_func == T_FUN_SYS_RB_AND_AGG && !is_first) {
+        ret = rb.value_and(input_rb);
+      } else {
+        ret = rb.value_or(input_rb);
+      }
+      if (OB_FAIL(ret)) {
+        SQL_LOG(WARN, "failed to calculate roaringbitmap", K(ret));
+      } else {
+        not_nulls.set(agg_col_id);
+      }
+      ObRbUtils::rb_destroy(input_rb);
+    }
+    return ret;
+  }
+
+  // serialize the bitmap into result cell and recycle it
+  int store_result(RuntimeContext &agg_ctx, char *agg_cell, BitmapNode *node)
+  {
+    int ret = OB_SUCCESS;
+    ObEvalCtx::TempAllocGuard alloc_guard(agg_ctx.eval_ctx_);
+    lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+    ObRoaringBitmap *rb = &node->rb_;
+    ObString rb_bin;
+    char *res_buf = EXTRACT_MEM_ADDR(agg_cell);
+    int32_t res_buf_len = *reinterpret_cast<const int32_t *>(agg_cell + sizeof(char *));
+    if (OB_FAIL(ObRbUtils::rb_serialize(alloc_guard.get_allocator(), rb_bin, rb))) {
+      SQL_LOG(WARN, "failed to serialize roaringbitmap", K(ret));
+    } else if (OB_NOT_NULL(res_buf) && res_buf_len >= rb_bin.length()) {
+      // the bitmap has been spilled before, reuse its result buffer
+    } else if (OB_ISNULL(res_buf = (char *)agg_ctx.allocator_.alloc(rb_bin.length()))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SQL_LOG(WARN, "allocate memory failed", K(ret), K(rb_bin.length()));
+    }
+    if (OB_SUCC(ret)) {
+      MEMCPY(res_buf, rb_bin.ptr(), rb_bin.length());
+      STORE_MEM_ADDR(res_buf, agg_cell);
+      *reinterpret_cast<int32_t *>(agg_cell + sizeof(char *)) = rb_bin.length();
+      *reinterpret_cast<int64_t *>(agg_cell + RES_CELL_SIZE) = 0;
+      free_node(node);
+    }
+    return ret;
+  }
+
+  int alloc_node(BitmapNode *&node)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_NOT_NULL(free_nodes_)) {
+      node = free_nodes_;
+      free_nodes_ = node->free_next_;
+      node->free_next_ = nullptr;
+    } else if (OB_ISNULL(node = OB_NEWx(BitmapNode, &rb_allocator_, &rb_allocator_))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SQL_LOG(WARN, "allocate memory failed", K(ret));
+    } else {
+      node->next_ = all_nodes_;
+      all_nodes_ = node;
+    }
+    if (OB_SUCC(ret)) {
+      live_cnt_++;
+    }
+    return ret;
+  }
+
+  void free_node(BitmapNode *node)
+  {
+    lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+    node->rb_.set_empty();
+    node->agg_cell_ = nullptr;
+    node->free_next_ = free_nodes_;
+    free_nodes_ = node;
+    live_cnt_--;
+  }
+
+  // Only called when no bitmap is referenced by the caller, i.e. after a row or a batch is added.
+  int spill_bitmaps_if_needed(RuntimeContext &agg_ctx)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_UNLIKELY(live_cnt_ > MAX_LIVE_BITMAP_CNT)) {
+      SQL_LOG(DEBUG, "spill roaringbitmaps", K(live_cnt_));
+      for (BitmapNode *node = all_nodes_; OB_SUCC(ret) && node != nullptr; node = node->next_) {
+        if (OB_ISNULL(node->agg_cell_)) {
+        } else if (OB_FAIL(store_result(agg_ctx, node->agg_cell_, node))) {
+          SQL_LOG(WARN, "store roaringbitmap result failed", K(ret));
+        }
+      }
+    }
+    return ret;
+  }
+
+  void release_all_bitmaps()
+  {
+    lib::ObMallocHookAttrGuard malloc_guard(mem_attr_);
+    for (BitmapNode *node = all_nodes_; node != nullptr; node = node->next_) {
+      node->rb_.set_empty();
+    }
+    all_nodes_ = nullptr;
+    free_nodes_ = nullptr;
+    live_cnt_ = 0;
+    batch_cnt_ = 0;
+  }
+
+private:
+  // bitmaps are not allocated by agg_ctx.allocator_, which is reset before `reuse`/`destroy`
+  // of aggregates is called.
+  ObArenaAllocator rb_allocator_;
+  ObMemAttr mem_attr_;
+  BitmapNode *all_nodes_;
+  BitmapNode *free_nodes_;
+  // number of nodes which hold the bitmap of a group
+  int64_t live_cnt_;
+  uint64_t *batch_vals_;
+  int64_t batch_cnt_;
+  int64_t batch_cap_;
+  ObObjType param_type_;
+  bool has_lob_header_;
+};
+
+} // end aggregate
+} // end share
+} // end oceanbase
+#endif // OCEANBASE_SHARE_AGGREGATE_RB_AGG_H_
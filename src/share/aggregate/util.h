@@ -607,7 +607,10 @@ inline bool supported_aggregate_function(const ObItemType agg_op)
   case T_FUN_APPROX_COUNT_DISTINCT_SYNOPSIS_MERGE:
   case T_FUN_SYS_BIT_OR:
   case T_FUN_SYS_BIT_AND:
-  case T_FUN_SYS_BIT_XOR: {
+  case T_FUN_SYS_BIT_XOR:
+  case T_FUN_SYS_RB_BUILD_AGG:
+  case T_FUN_SYS_RB_OR_AGG:
+  case T_FUN_SYS_RB_AND_AGG: {
     return true;
   }
   default:
@@ -146,6 +146,9 @@ void* ObMemstoreAllocator::alloc(AllocHandle& handle, int64_t size, const int64_
     if (is_throttled) {
       share::memstore_throttled_alloc() += align_size;
     }
+    if (smooth_throttle_bucket_.is_limited()) {
+      share::memstore_smooth_throttle_alloc() += align_size;
+    }
     res = arena_.alloc(handle.id_, handle.arena_handle_, align_size);
   }
   return res;
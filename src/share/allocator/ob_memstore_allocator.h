@@ -16,6 +16,7 @@
 #include "ob_fifo_arena.h"
 #include "lib/lock/ob_spin_lock.h"
 #include "share/throttle/ob_share_throttle_define.h"
+#include "share/throttle/ob_throttle_token_bucket.h"
 
 namespace oceanbase
 {
@@ -34,6 +35,13 @@ OB_INLINE int64_t &memstore_throttled_alloc()
   return throttled_alloc;
 }
 
+// record the memstore size allocated under smooth throttle in this thread
+OB_INLINE int64_t &memstore_smooth_throttle_alloc()
+{
+  RLOCAL_INLINE(int64_t, smooth_throttle_alloc);
+  return smooth_throttle_alloc;
+}
+
 struct FrozenMemstoreInfoLogger
 {
   FrozenMemstoreInfoLogger(char* buf, int64_t limit): buf_(buf), limit_(limit), pos_(0) {}
@@ -123,7 +131,11 @@ public:
 
 public:
   ObMemstoreAllocator()
-      : throttle_tool_(nullptr), lock_(common::ObLatchIds::MEMSTORE_ALLOCATOR_LOCK), hlist_(), arena_() {}
+      : throttle_tool_(nullptr),
+        lock_(common::ObLatchIds::MEMSTORE_ALLOCATOR_LOCK),
+        hlist_(),
+        arena_(),
+        smooth_throttle_bucket_() {}
   ~ObMemstoreAllocator() {}
 public:
   int init();
@@ -183,6 +195,10 @@ public:
 
 public:
   int set_memstore_threshold();
+  // the smooth throttle is driven by ObTenantFreezer, which sets the bucket rate according to the predicted memstore
+  // write speed and dump speed. alloc() only records the allocated size, the tokens are consumed by ObStorageTableGuard
+  // when the writer really sleeps, so replay and writes on frozen memtables never charge the bucket.
+  ObThrottleTokenBucket &smooth_throttle_bucket() { return smooth_throttle_bucket_; }
 
 private:
   int64_t nway_per_group();
@@ -192,6 +208,7 @@ private:
   Lock lock_;
   HandleList hlist_;
   Arena arena_;
+  ObThrottleTokenBucket smooth_throttle_bucket_;
 };
 
 };     // namespace share
@@ -18,6 +18,7 @@
 #include "logservice/palf/fetch_log_engine.h"
 #include "logservice/palf/log_shared_task.h"
 #include "logservice/replayservice/ob_replay_status.h"
+#include "share/config/ob_server_config.h"
 #ifdef OB_BUILD_SHARED_STORAGE
 #include "log/ob_log_fast_rebuild_engine.h"         // ObLogFastRebuildEngine
 #endif
@@ -73,6 +74,16 @@ ObTenantMutilAllocator::ObTenantMutilAllocator(uint64_t tenant_id)
     const int32_t nway = (int32_t)max_cpu;
     set_nway(nway);
   }
+  // every log append allocates and frees a submit task and a flush task
+  if (GCONF._enable_log_task_alloc_magazine) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = log_handle_submit_task_alloc_.enable_magazine())) {
+      OB_LOG_RET(WARN, tmp_ret, "enable magazine for log handle submit task failed", K(tmp_ret), K(tenant_id));
+    }
+    if (OB_SUCCESS != (tmp_ret = log_io_flush_log_task_alloc_.enable_magazine())) {
+      OB_LOG_RET(WARN, tmp_ret, "enable magazine for log io flush log task failed", K(tmp_ret), K(tenant_id));
+    }
+  }
 }
 
 ObTenantMutilAllocator::~ObTenantMutilAllocator()
@@ -118,7 +129,9 @@ int ObTenantMutilAllocator::choose_blk_size(int obj_size)
 void ObTenantMutilAllocator::try_purge()
 {
   clog_ge_alloc_.purge_extra_cached_block(0);
+  log_handle_submit_task_alloc_.purge_magazine();
   log_handle_submit_task_alloc_.purge_extra_cached_block(0);
+  log_io_flush_log_task_alloc_.purge_magazine();
   log_io_flush_log_task_alloc_.purge_extra_cached_block(0);
   log_io_truncate_log_task_alloc_.purge_extra_cached_block(0);
   log_io_flush_meta_task_alloc_.purge_extra_cached_block(0);
@@ -26,10 +26,6 @@ using namespace oceanbase::common;
 using namespace oceanbase::share;
 using namespace oceanbase::sql;
 
-#define GET_OTHER_TSI_ADDR(var_name, addr) \
-const int64_t var_name##_offset = ((int64_t)addr - (int64_t)pthread_self()); \
-decltype(*addr) var_name = *(decltype(addr))(thread_base + var_name##_offset);
-
 ObActiveSessHistTask &ObActiveSessHistTask::get_instance()
 {
   static ObActiveSessHistTask the_one;
@@ -88,25 +84,13 @@ void ObActiveSessHistTask::runTimerTask()
     // iter over session mgr
     sample_time_ = ObTimeUtility::current_time();
     GCTX.session_mgr_->for_each_session(*this);
-    // iter over each thread
-    StackMgr::Guard guard(g_stack_mgr);
-    for (auto* header = *guard; OB_NOT_NULL(header); header = guard.next()) {
-      auto* thread_base = (char*)(header->pth_);
-      if (OB_NOT_NULL(thread_base)) {
-        GET_OTHER_TSI_ADDR(tid, &get_tid_cache());
-        {
-          char path[64];
-          IGNORE_RETURN snprintf(path, 64, "/proc/self/task/%ld", tid);
-          if (-1 == access(path, F_OK)) {
-            // thread not exist, may have exited.
-            continue;
-          }
-        }
-        GET_OTHER_TSI_ADDR(ash_stat, &ObActiveSessionGuard::thread_local_stat_);
-        if (ash_stat.in_das_remote_exec_ == true) {
-          ash_stat.sample_time_ = sample_time_;
-          ObActiveSessHistList::get_instance().add(ash_stat);
-        }
+    // iter over threads running without session, only slots ever used are visited
+    const int64_t slot_cnt = ObActiveSessionThreadSlots::slot_count();
+    for (int64_t i = 0; i < slot_cnt; i++) {
+      ActiveSessionStat &ash_stat = ObActiveSessionThreadSlots::get(i);
+      if (ObActiveSessionThreadSlots::is_used(i) && ash_stat.in_das_remote_exec_ == true) {
+        ash_stat.sample_time_ = sample_time_;
+        ObActiveSessHistList::get_instance().add(ash_stat);
       }
     }
   }
@@ -510,6 +510,9 @@ int ObOrderPerservingEncoder::encode_from_string_varlen(
   if ((to_len + 7 * str.length() + safety_buf_size) > max_buf_len) {
     ret = OB_BUF_NOT_ENOUGH;
     LOG_TRACE("no enough memory to do encoding for string", K(ret));
+  } else if (ObCharset::is_uca_900_nopad(cs)) {
+    // '\0' is ignorable in UCA 9.0.0, so empty string is encoded by strnxfrm as well
+    ret = encode_from_string_uca_900(str, to, max_buf_len - to_len - safety_buf_size, to_len, cs);
   } else if (str.empty() ||  (str.length()==1 && *str.ptr()=='\0')) {
     if (OB_FAIL(encode_tails(to, max_buf_len, to_len, is_mem, cs, str.length()==1 && *str.ptr()=='\0'))) {
       LOG_WARN("failed to encode tails", K(ret));
@@ -563,6 +566,9 @@ int ObOrderPerservingEncoder::encode_from_string_varlen(
   if ((to_len + 7 * str.length() + safty_buf_size) > max_buf_len) {
     ret = OB_BUF_NOT_ENOUGH;
     LOG_TRACE("no enough memory to do encoding for string", K(ret));
+  } else if (ObCharset::is_uca_900_nopad(cs)) {
+    // '\0' is ignorable in UCA 9.0.0, so empty string is encoded by strnxfrm as well
+    ret = encode_from_string_uca_900(str, to, max_buf_len - to_len - safty_buf_size, to_len, cs);
   } else if (str.empty() || (str.length()==1 && *str.ptr()=='\0')) {
     if (OB_FAIL(encode_tails(to, max_buf_len, to_len, param.is_memcmp_, cs, str.length()==1 && *str.ptr()=='\0'))) {
       LOG_WARN("failed to encode tails", K(ret));
@@ -596,6 +602,27 @@ int ObOrderPerservingEncoder::encode_from_string_varlen(
   return ret;
 }
 
+int ObOrderPerservingEncoder::encode_from_string_uca_900(
+  ObString str, unsigned char *to, int64_t max_buf_len, int64_t &to_len, ObCollationType cs)
+{
+  int ret = OB_SUCCESS;
+  bool is_complete = false;
+  // weights of UCA 9.0.0 are not bounded by the length of str, the buffer is not enough
+  // if the weight string is truncated, and the caller will retry with a larger buffer.
+  int64_t res_len = ObCharset::sortkey_var_len(cs, str.ptr(), str.length(), (char *)to,
+                                               max_buf_len, true, is_complete);
+  if (res_len < 0) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_TRACE("not support collation", K(cs));
+  } else if (!is_complete) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_TRACE("no enough memory to do encoding for string", K(ret), K(max_buf_len));
+  } else {
+    to_len += res_len;
+  }
+  return ret;
+}
+
 int ObOrderPerservingEncoder::encode_from_string_fixlen(
   ObString str, unsigned char *to, int64_t max_buf_len, int64_t &to_len, ObEncParam &param)
 {
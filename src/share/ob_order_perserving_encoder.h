@@ -94,6 +94,8 @@ public:
     ObString val, unsigned char *to, int64_t max_buf_len, int64_t &to_len, ObEncParam &param);
   static int encode_from_string_varlen(
     ObString val, unsigned char *to, int64_t max_buf_len, int64_t &to_len, ObCollationType cs);
+  static int encode_from_string_uca_900(
+    ObString val, unsigned char *to, int64_t max_buf_len, int64_t &to_len, ObCollationType cs);
   static int encode_from_int8(int8_t val, unsigned char *to, int64_t &to_len);
   static int encode_from_int16(int16_t val, unsigned char *to, int64_t &to_len);
   static int encode_from_int32(int32_t val, unsigned char *to, int64_t &to_len);
@@ -140,7 +142,8 @@ public:
               || cs == CS_TYPE_GBK_CHINESE_CI
               // utf 16 will be open later
               //|| cs == CS_TYPE_UTF16_GENERAL_CI || cs == CS_TYPE_UTF16_BIN
-              || cs == CS_TYPE_GB18030_CHINESE_CI || ObCharset::is_gb18030_2022(cs));
+              || cs == CS_TYPE_GB18030_CHINESE_CI || ObCharset::is_gb18030_2022(cs)
+              || ObCharset::is_uca_900_nopad(cs));
   }
 
 private:
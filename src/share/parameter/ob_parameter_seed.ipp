@@ -464,6 +464,11 @@ DEF_INT(_mds_memory_limit_percentage, OB_TENANT_PARAMETER, "10", "(0, 100)",
 DEF_TIME(writing_throttling_maximum_duration, OB_TENANT_PARAMETER, "2h", "[1s, 3d]",
           "maximum duration of writting throttling(in minutes), max value is 3 days",
           ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_memstore_predictive_freeze, OB_TENANT_PARAMETER, "False",
+         "specifies whether to freeze the memstore in advance according to the predicted write speed and dump speed, "
+         "and smooth the write speed with a token bucket before the writing throttling is triggered. "
+         "Value:  True: turned on;  False: turned off",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_TIME(plan_cache_evict_interval, OB_CLUSTER_PARAMETER, "5s", "[0s,)",
          "time interval for periodic plan cache eviction. Range: [0s, +∞)",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -634,7 +639,8 @@ DEF_STR_WITH_CHECKER(log_transport_compress_func, OB_TENANT_PARAMETER, "lz4_1.0"
                      ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_BOOL(log_storage_compress_all, OB_TENANT_PARAMETER, "False",
-         "specifies whether to compress logs before storing. The default is false(no compression)",
+         "specifies whether to compress logs before storing. The default is false(no compression). "
+         "Enable it only after all servers of the tenant can decode compressed logs",
          ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_STR_WITH_CHECKER(log_storage_compress_func, OB_TENANT_PARAMETER, "lz4_1.0",
@@ -732,6 +738,12 @@ DEF_BOOL(_enable_log_cache, OB_TENANT_PARAMETER, "True",
          "specifies whether allow to fill log kv cache. "
          "Value:  True:turned on  False: turned off",
          ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_log_task_alloc_magazine, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether to cache the freed log submit and flush tasks in per-cpu magazines, "
+         "which reduces the contention on the shared task allocator blocks. "
+         "It takes effect for the tenants created or loaded after it is set. "
+         "Value:  True:turned on  False: turned off",
+         ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 DEF_BOOL(_ob_enable_standby_db_parallel_log_transport, OB_TENANT_PARAMETER, "True",
         "Specifies whether the parallel log transport protocol is enabled on the standby database. "
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_throttle_token_bucket.h"
+
+#include "lib/literals/ob_literals.h"
+
+namespace oceanbase {
+namespace share {
+
+void ObThrottleTokenBucket::reset()
+{
+  ATOMIC_STORE(&rate_, 0);
+  ATOMIC_STORE(&burst_size_, 0);
+  ATOMIC_STORE(&next_free_ts_, 0);
+}
+
+void ObThrottleTokenBucket::set_rate(const int64_t rate, const int64_t burst_size)
+{
+  ATOMIC_STORE(&burst_size_, MAX(0, burst_size));
+  ATOMIC_STORE(&rate_, MAX(0, rate));
+}
+
+int64_t ObThrottleTokenBucket::consume(const int64_t alloc_size, const int64_t current_ts)
+{
+  int64_t wait_time = 0;
+  const int64_t rate = ATOMIC_LOAD(&rate_);
+  if (rate > 0 && alloc_size > 0) {
+    const int64_t burst_size = ATOMIC_LOAD(&burst_size_);
+    // use double to avoid overflow when the alloc size is large
+    const int64_t cost_time = static_cast<int64_t>(static_cast<double>(alloc_size) * 1_s / rate);
+    const int64_t burst_time = static_cast<int64_t>(static_cast<double>(burst_size) * 1_s / rate);
+    int64_t old_ts = 0;
+    int64_t new_ts = 0;
+    do {
+      old_ts = ATOMIC_LOAD(&next_free_ts_);
+      // the tokens which are not used in the past are dropped, so the bucket never holds more than burst_size
+      new_ts = MAX(old_ts, current_ts) + cost_time;
+    } while (!ATOMIC_BCAS(&next_free_ts_, old_ts, new_ts));
+    wait_time = MAX(0, new_ts - current_ts - burst_time);
+  }
+  return wait_time;
+}
+
+void ObThrottleTokenBucket::refund(const int64_t unused_wait_time)
+{
+  if (unused_wait_time > 0) {
+    (void)ATOMIC_SAF(&next_free_ts_, unused_wait_time);
+  }
+}
+
+}  // namespace share
+}  // namespace oceanbase
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEABASE_SHARE_THROTTLE_OB_THROTTLE_TOKEN_BUCKET_H
+#define OCEABASE_SHARE_THROTTLE_OB_THROTTLE_TOKEN_BUCKET_H
+
+#include "lib/ob_define.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace share {
+
+/**
+ * @brief Lock free token bucket used to smooth resource allocation.
+ *
+ * The bucket is implemented as a generic cell rate algorithm: instead of counting tokens, it records the theoretical
+ * time at which the bucket becomes empty again (next_free_ts_). Every allocation pushes next_free_ts_ forward by the
+ * time needed to refill its size, and the caller only needs to wait for the part that exceeds the burst tolerance.
+ *
+ * A rate of 0 means the bucket is disabled and consume() always returns 0.
+ */
+class ObThrottleTokenBucket
+{
+public:
+  ObThrottleTokenBucket() : rate_(0), burst_size_(0), next_free_ts_(0) {}
+  ~ObThrottleTokenBucket() {}
+
+  void reset();
+
+  /**
+   * @brief Update the refill speed of the bucket.
+   *
+   * @param[in] rate The refill speed in bytes per second. 0 disables the bucket.
+   * @param[in] burst_size The bytes which can be allocated without any waiting.
+   */
+  void set_rate(const int64_t rate, const int64_t burst_size);
+
+  /**
+   * @brief Consume tokens for the allocation.
+   *
+   * @param[in] alloc_size The allocated bytes.
+   * @param[in] current_ts The current timestamp in microseconds.
+   * @return The time in microseconds that the caller should wait before continuing.
+   */
+  int64_t consume(const int64_t alloc_size, const int64_t current_ts);
+
+  /**
+   * @brief Give back the waiting time which is charged by consume() but not taken by the caller, e.g. the sleep is
+   * cut short by the statement timeout.
+   *
+   * @param[in] unused_wait_time The waiting time in microseconds which is not taken.
+   */
+  void refund(const int64_t unused_wait_time);
+
+  bool is_limited() const { return ATOMIC_LOAD(&rate_) > 0; }
+  int64_t get_rate() const { return ATOMIC_LOAD(&rate_); }
+
+  TO_STRING_KV(K_(rate), K_(burst_size), K_(next_free_ts));
+
+private:
+  int64_t rate_;
+  int64_t burst_size_;
+  int64_t next_free_ts_;
+};
+
+}  // namespace share
+}  // namespace oceanbase
+
+#endif
@@ -11,10 +11,112 @@
  */
 
 #include "ob_vector_cosine_distance.h"
+#include "common/ob_target_specific.h"
+#include <cmath>
+
+#if OB_USE_MULTITARGET_CODE
+#include <immintrin.h>
+#endif
+
 namespace oceanbase
 {
 namespace common
 {
+// Products are computed in float and summed in double as cosine_calculate_normal does.
+// The inner product may turn into NaN when infs of both signs are added, so overflow is
+// checked with isfinite after the loop.
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+inline static double reduce_add(const __m512d lo, const __m512d hi)
+{
+  return _mm512_reduce_add_pd(_mm512_add_pd(lo, hi));
+}
+
+inline static void add_widened(const __m512 prod, __m512d &lo, __m512d &hi)
+{
+  lo = _mm512_add_pd(lo, _mm512_cvtps_pd(_mm512_castps512_ps256(prod)));
+  hi = _mm512_add_pd(hi, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(prod), 1))));
+}
+
+int cosine_calculate(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+{
+  int ret = OB_SUCCESS;
+  __m512d ip_lo = _mm512_setzero_pd();
+  __m512d ip_hi = _mm512_setzero_pd();
+  __m512d a_lo = _mm512_setzero_pd();
+  __m512d a_hi = _mm512_setzero_pd();
+  __m512d b_lo = _mm512_setzero_pd();
+  __m512d b_hi = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 va = _mm512_loadu_ps(a + i);
+    __m512 vb = _mm512_loadu_ps(b + i);
+    add_widened(_mm512_mul_ps(va, vb), ip_lo, ip_hi);
+    add_widened(_mm512_mul_ps(va, va), a_lo, a_hi);
+    add_widened(_mm512_mul_ps(vb, vb), b_lo, b_hi);
+  }
+  ip += reduce_add(ip_lo, ip_hi);
+  abs_dist_a += reduce_add(a_lo, a_hi);
+  abs_dist_b += reduce_add(b_lo, b_hi);
+  for (; i < len; ++i) {
+    ip += a[i] * b[i];
+    abs_dist_a += a[i] * a[i];
+    abs_dist_b += b[i] * b[i];
+  }
+  if (OB_UNLIKELY(!std::isfinite(ip) || !std::isfinite(abs_dist_a) || !std::isfinite(abs_dist_b))) {
+    ret = OB_NUMERIC_OVERFLOW;
+    LIB_LOG(WARN, "value is overflow", K(ret), K(ip), K(abs_dist_a), K(abs_dist_b));
+  }
+  return ret;
+}
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+inline static double reduce_add(const __m256d lo, const __m256d hi)
+{
+  __m256d sum4 = _mm256_add_pd(lo, hi);
+  __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum4), _mm256_extractf128_pd(sum4, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+}
+
+inline static void add_widened(const __m256 prod, __m256d &lo, __m256d &hi)
+{
+  lo = _mm256_add_pd(lo, _mm256_cvtps_pd(_mm256_castps256_ps128(prod)));
+  hi = _mm256_add_pd(hi, _mm256_cvtps_pd(_mm256_extractf128_ps(prod, 1)));
+}
+
+int cosine_calculate(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+{
+  int ret = OB_SUCCESS;
+  __m256d ip_lo = _mm256_setzero_pd();
+  __m256d ip_hi = _mm256_setzero_pd();
+  __m256d a_lo = _mm256_setzero_pd();
+  __m256d a_hi = _mm256_setzero_pd();
+  __m256d b_lo = _mm256_setzero_pd();
+  __m256d b_hi = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 va = _mm256_loadu_ps(a + i);
+    __m256 vb = _mm256_loadu_ps(b + i);
+    add_widened(_mm256_mul_ps(va, vb), ip_lo, ip_hi);
+    add_widened(_mm256_mul_ps(va, va), a_lo, a_hi);
+    add_widened(_mm256_mul_ps(vb, vb), b_lo, b_hi);
+  }
+  ip += reduce_add(ip_lo, ip_hi);
+  abs_dist_a += reduce_add(a_lo, a_hi);
+  abs_dist_b += reduce_add(b_lo, b_hi);
+  for (; i < len; ++i) {
+    ip += a[i] * b[i];
+    abs_dist_a += a[i] * a[i];
+    abs_dist_b += b[i] * b[i];
+  }
+  if (OB_UNLIKELY(!std::isfinite(ip) || !std::isfinite(abs_dist_a) || !std::isfinite(abs_dist_b))) {
+    ret = OB_NUMERIC_OVERFLOW;
+    LIB_LOG(WARN, "value is overflow", K(ret), K(ip), K(abs_dist_a), K(abs_dist_b));
+  }
+  return ret;
+}
+)
+
 int ObVectorCosineDistance::cosine_similarity_func(const float *a, const float *b, const int64_t len, double &similarity)
 {
   return cosine_similarity_normal(a, b, len, similarity);
@@ -43,7 +145,24 @@ OB_INLINE double ObVectorCosineDistance::get_cosine_distance(double similarity)
   return 1.0 - similarity;
 }
 
-OB_INLINE int ObVectorCosineDistance::cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+int ObVectorCosineDistance::cosine_calculate_func(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
+{
+  int ret = OB_SUCCESS;
+#if OB_USE_MULTITARGET_CODE
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    ret = common::specific::avx512::cosine_calculate(a, b, len, ip, abs_dist_a, abs_dist_b);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    ret = common::specific::avx2::cosine_calculate(a, b, len, ip, abs_dist_a, abs_dist_b);
+  } else {
+    ret = cosine_calculate_normal(a, b, len, ip, abs_dist_a, abs_dist_b);
+  }
+#else
+  ret = cosine_calculate_normal(a, b, len, ip, abs_dist_a, abs_dist_b);
+#endif
+  return ret;
+}
+
+int ObVectorCosineDistance::cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b)
 {
   int ret = OB_SUCCESS;
   for (int64_t i = 0; OB_SUCC(ret) && i < len; ++i) {
@@ -65,7 +184,7 @@ OB_INLINE int ObVectorCosineDistance::cosine_similarity_normal(const float *a, c
   double abs_dist_a = 0;
   double abs_dist_b = 0;
   similarity = 0;
-  if (OB_FAIL(cosine_calculate_normal(a, b, len, ip, abs_dist_a, abs_dist_b))) {
+  if (OB_FAIL(cosine_calculate_func(a, b, len, ip, abs_dist_a, abs_dist_b))) {
     LIB_LOG(WARN, "failed to cal cosine", K(ret), K(ip));
   } else if (0 == abs_dist_a || 0 == abs_dist_b) {
     ret = OB_ERR_NULL_VALUE;
@@ -17,6 +17,7 @@
 #include "lib/oblog/ob_log.h"
 #include "lib/ob_define.h"
 #include "common/object/ob_obj_compare.h"
+#include "common/ob_target_specific.h"
 
 namespace oceanbase
 {
@@ -26,13 +27,22 @@ struct ObVectorCosineDistance
 {
   static int cosine_similarity_func(const float *a, const float *b, const int64_t len, double &similarity);
   static int cosine_distance_func(const float *a, const float *b, const int64_t len, double &distance);
+  // avx2/avx512 versions are selected at runtime
+  static int cosine_calculate_func(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
 
   // normal func
   OB_INLINE static int cosine_similarity_normal(const float *a, const float *b, const int64_t len, double &similarity);
-  OB_INLINE static int cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
+  static int cosine_calculate_normal(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
   OB_INLINE static double get_cosine_distance(double similarity);
-  // TODO(@jingshui) add simd func
 };
+
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+int cosine_calculate(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+int cosine_calculate(const float *a, const float *b, const int64_t len, double &ip, double &abs_dist_a, double &abs_dist_b);
+)
 } // common
 } // oceanbase
 #endif
\ No newline at end of file
@@ -11,16 +11,92 @@
  */
 
 #include "ob_vector_ip_distance.h"
+#include "common/ob_target_specific.h"
+#include <cmath>
+
+#if OB_USE_MULTITARGET_CODE
+#include <immintrin.h>
+#endif
+
 namespace oceanbase
 {
 namespace common
 {
+// Products are computed in float and summed in double as ip_distance_normal does.
+// Overflow is checked after the loop: an overflowed lane stays inf, or turns into NaN once
+// it meets an inf of the other sign, so any non-finite sum is reported.
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+int ip_distance(const float *a, const float *b, const int64_t len, double &distance)
+{
+  int ret = OB_SUCCESS;
+  __m512d sum_lo = _mm512_setzero_pd();
+  __m512d sum_hi = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 prod = _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    sum_lo = _mm512_add_pd(sum_lo, _mm512_cvtps_pd(_mm512_castps512_ps256(prod)));
+    sum_hi = _mm512_add_pd(sum_hi, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(prod), 1))));
+  }
+  double sum = distance + _mm512_reduce_add_pd(_mm512_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    sum += a[i] * b[i];
+  }
+  if (OB_UNLIKELY(!std::isfinite(sum))) {
+    ret = OB_NUMERIC_OVERFLOW;
+    LIB_LOG(WARN, "value is overflow", K(ret), K(sum));
+  } else {
+    distance = sum;
+  }
+  return ret;
+}
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+int ip_distance(const float *a, const float *b, const int64_t len, double &distance)
+{
+  int ret = OB_SUCCESS;
+  __m256d sum_lo = _mm256_setzero_pd();
+  __m256d sum_hi = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 prod = _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    sum_lo = _mm256_add_pd(sum_lo, _mm256_cvtps_pd(_mm256_castps256_ps128(prod)));
+    sum_hi = _mm256_add_pd(sum_hi, _mm256_cvtps_pd(_mm256_extractf128_ps(prod, 1)));
+  }
+  __m256d sum4 = _mm256_add_pd(sum_lo, sum_hi);
+  __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum4), _mm256_extractf128_pd(sum4, 1));
+  double sum = distance + _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+  for (; i < len; ++i) {
+    sum += a[i] * b[i];
+  }
+  if (OB_UNLIKELY(!std::isfinite(sum))) {
+    ret = OB_NUMERIC_OVERFLOW;
+    LIB_LOG(WARN, "value is overflow", K(ret), K(sum));
+  } else {
+    distance = sum;
+  }
+  return ret;
+}
+)
+
 int ObVectorIpDistance::ip_distance_func(const float *a, const float *b, const int64_t len, double &distance)
 {
-return ip_distance_normal(a, b, len, distance);
+  int ret = OB_SUCCESS;
+#if OB_USE_MULTITARGET_CODE
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    ret = common::specific::avx512::ip_distance(a, b, len, distance);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    ret = common::specific::avx2::ip_distance(a, b, len, distance);
+  } else {
+    ret = ip_distance_normal(a, b, len, distance);
+  }
+#else
+  ret = ip_distance_normal(a, b, len, distance);
+#endif
+  return ret;
 }
 
-OB_INLINE int ObVectorIpDistance::ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance)
+int ObVectorIpDistance::ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance)
 {
   int ret = OB_SUCCESS;
   for (int64_t i = 0; OB_SUCC(ret) && i < len; ++i) {
@@ -17,6 +17,7 @@
 #include "lib/oblog/ob_log.h"
 #include "lib/ob_define.h"
 #include "common/object/ob_obj_compare.h"
+#include "common/ob_target_specific.h"
 
 namespace oceanbase
 {
@@ -27,10 +28,18 @@ struct ObVectorIpDistance
   static int ip_distance_func(const float *a, const float *b, const int64_t len, double &distance);
 
   // normal func
-  OB_INLINE static int ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance);
-  // TODO(@jingshui) add simd func
+  static int ip_distance_normal(const float *a, const float *b, const int64_t len, double &distance);
+  // avx2/avx512 versions are selected at runtime in ip_distance_func
 };
 
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+int ip_distance(const float *a, const float *b, const int64_t len, double &distance);
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+int ip_distance(const float *a, const float *b, const int64_t len, double &distance);
+)
+
 } // common
 } // oceanbase
 #endif
\ No newline at end of file
@@ -11,13 +11,95 @@
  */
 
 #include "ob_vector_l2_distance.h"
+#include "common/ob_target_specific.h"
+#include <cmath>
+
+#if OB_USE_MULTITARGET_CODE
+#include <immintrin.h>
+#endif
+
 namespace oceanbase
 {
 namespace common
 {
+// Same as l2_square_normal: the difference is computed in float and squared and summed in
+// double, so only the summation order differs. Once a partial sum overflows it stays non-finite,
+// so overflow is checked after the loop.
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+int l2_square(const float *a, const float *b, const int64_t len, double &square)
+{
+  int ret = OB_SUCCESS;
+  __m512d sum_lo = _mm512_setzero_pd();
+  __m512d sum_hi = _mm512_setzero_pd();
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m512 diff = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    __m512d diff_lo = _mm512_cvtps_pd(_mm512_castps512_ps256(diff));
+    __m512d diff_hi = _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(diff), 1)));
+    sum_lo = _mm512_add_pd(sum_lo, _mm512_mul_pd(diff_lo, diff_lo));
+    sum_hi = _mm512_add_pd(sum_hi, _mm512_mul_pd(diff_hi, diff_hi));
+  }
+  double sum = _mm512_reduce_add_pd(_mm512_add_pd(sum_lo, sum_hi));
+  for (; i < len; ++i) {
+    double diff = a[i] - b[i];
+    sum += (diff * diff);
+  }
+  if (OB_UNLIKELY(!std::isfinite(sum))) {
+    ret = OB_NUMERIC_OVERFLOW;
+    LIB_LOG(WARN, "value is overflow", K(ret), K(sum));
+  } else {
+    square = sum;
+  }
+  return ret;
+}
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+int l2_square(const float *a, const float *b, const int64_t len, double &square)
+{
+  int ret = OB_SUCCESS;
+  __m256d sum_lo = _mm256_setzero_pd();
+  __m256d sum_hi = _mm256_setzero_pd();
+  int64_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    __m256d diff_lo = _mm256_cvtps_pd(_mm256_castps256_ps128(diff));
+    __m256d diff_hi = _mm256_cvtps_pd(_mm256_extractf128_ps(diff, 1));
+    sum_lo = _mm256_add_pd(sum_lo, _mm256_mul_pd(diff_lo, diff_lo));
+    sum_hi = _mm256_add_pd(sum_hi, _mm256_mul_pd(diff_hi, diff_hi));
+  }
+  __m256d sum4 = _mm256_add_pd(sum_lo, sum_hi);
+  __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum4), _mm256_extractf128_pd(sum4, 1));
+  double sum = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+  for (; i < len; ++i) {
+    double diff = a[i] - b[i];
+    sum += (diff * diff);
+  }
+  if (OB_UNLIKELY(!std::isfinite(sum))) {
+    ret = OB_NUMERIC_OVERFLOW;
+    LIB_LOG(WARN, "value is overflow", K(ret), K(sum));
+  } else {
+    square = sum;
+  }
+  return ret;
+}
+)
+
 int ObVectorL2Distance::l2_square_func(const float *a, const float *b, const int64_t len, double &square)
 {
-  return l2_square_normal(a, b, len, square);
+  int ret = OB_SUCCESS;
+#if OB_USE_MULTITARGET_CODE
+  if (common::is_arch_supported(ObTargetArch::AVX512)) {
+    ret = common::specific::avx512::l2_square(a, b, len, square);
+  } else if (common::is_arch_supported(ObTargetArch::AVX2)) {
+    ret = common::specific::avx2::l2_square(a, b, len, square);
+  } else {
+    ret = l2_square_normal(a, b, len, square);
+  }
+#else
+  ret = l2_square_normal(a, b, len, square);
+#endif
+  return ret;
 }
 
 int ObVectorL2Distance::l2_distance_func(const float *a, const float *b, const int64_t len, double &distance)
@@ -33,7 +115,7 @@ int ObVectorL2Distance::l2_distance_func(const float *a, const float *b, const i
   return ret;
 }
 
-OB_INLINE int ObVectorL2Distance::l2_square_normal(const float *a, const float *b, const int64_t len, double &square)
+int ObVectorL2Distance::l2_square_normal(const float *a, const float *b, const int64_t len, double &square)
 {
   int ret = OB_SUCCESS;
   double sum = 0;
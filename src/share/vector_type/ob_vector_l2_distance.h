@@ -17,6 +17,7 @@
 #include "lib/oblog/ob_log.h"
 #include "lib/ob_define.h"
 #include "common/object/ob_obj_compare.h"
+#include "common/ob_target_specific.h"
 
 namespace oceanbase
 {
@@ -28,10 +29,18 @@ struct ObVectorL2Distance
   static int l2_distance_func(const float *a, const float *b, const int64_t len, double &distance);
 
   // normal func
-  OB_INLINE static int l2_square_normal(const float *a, const float *b, const int64_t len, double &square);
-  // TODO(@jingshui) add simd func
+  static int l2_square_normal(const float *a, const float *b, const int64_t len, double &square);
+  // avx2/avx512 versions are selected at runtime in l2_square_func
 };
 
+OB_DECLARE_AVX512_SPECIFIC_CODE(
+int l2_square(const float *a, const float *b, const int64_t len, double &square);
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+int l2_square(const float *a, const float *b, const int64_t len, double &square);
+)
+
 } // common
 } // oceanbase
 #endif
\ No newline at end of file
@@ -3976,7 +3976,8 @@ static int common_string_json(const ObExpr &expr,
       ObJsonOpaque j_opaque(j_text, in_type);
       ObJsonString j_string(j_text.ptr(), j_text.length());
       ObJsonNull j_null;
-      ObJsonNode *j_tree = NULL;
+      ObJsonBin j_bin(&temp_allocator);
+      ObString j_raw_bin;
       bool is_null_res = false;
       bool is_scalar = (j_text.length()
                         && ((j_text[0] == '\'' && j_text[j_text.length() - 1] == '\'')
@@ -4014,9 +4015,9 @@ static int common_string_json(const ObExpr &expr,
         }
       } else if (is_oracle && (OB_ISNULL(j_text.ptr()) || j_text.length() == 0)) {
         j_base = &j_null;
-      } else if (OB_FAIL(ObJsonParser::get_tree(&temp_allocator, j_text, j_tree,
-                                                parse_flag,
-                                                ObJsonExprHelper::get_json_max_depth_config()))) {
+      } else if (OB_FAIL(ObJsonParser::get_bin(&temp_allocator, j_text, j_raw_bin,
+                                               parse_flag,
+                                               ObJsonExprHelper::get_json_max_depth_config()))) {
         if (!is_oracle && CM_IS_IMPLICIT_CAST(expr.extra_) && !CM_IS_COLUMN_CONVERT(expr.extra_)) {
           ret = OB_SUCCESS;
           j_base = &j_string;
@@ -4042,8 +4043,10 @@ static int common_string_json(const ObExpr &expr,
             LOG_USER_ERROR(OB_ERR_INVALID_JSON_TEXT_IN_PARAM);
           }
         }
+      } else if (OB_FAIL(j_bin.reset(j_raw_bin, 0, nullptr))) {
+        LOG_WARN("fail to reset json bin", K(ret), K(in_type));
       } else {
-        j_base = j_tree;
+        j_base = &j_bin;
       }
 
       if (OB_SUCC(ret) && !is_null_res) {
@@ -17,6 +17,7 @@
 #include "share/ob_json_access_utils.h"
 #include "lib/json_type/ob_json_tree.h"
 #include "lib/xml/ob_binary_aggregate.h"
+#include "sql/engine/expr/ob_expr_lob_utils.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::sql;
@@ -176,53 +177,157 @@ int ObExprJsonExtract::eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObD
       }
     }
 
-    int32_t hit_size = hits.size();
-    ObJsonArray j_arr_res(&allocator);
-    ObStringBuffer value(&allocator);
-    ObIJsonBase *jb_res = NULL;
+    ObString res_str;
     if (OB_UNLIKELY(OB_FAIL(ret))) {
       LOG_WARN("json seek failed", K(ret));
-    } else if (hit_size == 0 || is_null_result) {
+    } else if (hits.size() == 0 || is_null_result) {
       res.set_null();
-    } else {
-      if (hit_size == 1 && (may_match_many == false)) {
-        jb_res = hits[0];
-        ObString raw_str;
-        if (OB_FAIL(ret)) {
-          LOG_WARN("json extarct get results failed", K(ret));
-        } else if (OB_FAIL(jb_res->get_raw_binary(raw_str, &allocator))) {
-          LOG_WARN("json extarct get result binary failed", K(ret));
-        } else if (OB_FAIL(ObJsonExprHelper::pack_json_str_res(expr, ctx, res, raw_str))) {
-          LOG_WARN("fail to pack json result", K(ret));
-        }
+    } else if (OB_FAIL(get_extract_result(allocator, hits, may_match_many, res_str))) {
+      LOG_WARN("json extarct get results failed", K(ret));
+    } else if (OB_FAIL(ObJsonExprHelper::pack_json_str_res(expr, ctx, res, res_str))) {
+      LOG_WARN("fail to pack json result", K(ret));
+    }
+  } else if (OB_SUCC(ret) && is_null_result) {
+    res.set_null();
+  }
+
+  return ret;
+}
+
+int ObExprJsonExtract::get_extract_result(ObIAllocator &allocator, ObJsonSeekResult &hits,
+                                          const bool may_match_many, ObString &res_str)
+{
+  int ret = OB_SUCCESS;
+  int32_t hit_size = hits.size();
+  if (hit_size == 1 && (may_match_many == false)) {
+    if (OB_FAIL(hits[0]->get_raw_binary(res_str, &allocator))) {
+      LOG_WARN("json extarct get result binary failed", K(ret));
+    }
+  } else {
+    ObBinAggSerializer bin_agg(&allocator, AGG_JSON, static_cast<uint8_t>(ObJsonNodeType::J_ARRAY));
+    ObStringBuffer value(&allocator);
+    ObJsonBin *j_node = NULL;
+    ObIJsonBase *jb_node = NULL;
+    for (int32_t i = 0; OB_SUCC(ret) && i < hit_size; i++) {
+      if (OB_FAIL(ObJsonBaseFactory::transform(&allocator, hits[i], ObJsonInType::JSON_BIN, jb_node))) { // to binary
+        LOG_WARN("fail to transform to tree", K(ret), K(i), K(*(hits[i])));
       } else {
-        ObBinAggSerializer bin_agg(&allocator, AGG_JSON, static_cast<uint8_t>(ObJsonNodeType::J_ARRAY));
-        ObJsonBin *j_node = NULL;
-        ObIJsonBase *jb_node = NULL;
-        for (int32_t i = 0; OB_SUCC(ret) && i < hit_size; i++) {
-          if (OB_FAIL(ObJsonBaseFactory::transform(&allocator, hits[i], ObJsonInType::JSON_BIN, jb_node))) { // to binary
-            LOG_WARN("fail to transform to tree", K(ret), K(i), K(*(hits[i])));
-          } else {
-            j_node = static_cast<ObJsonBin *>(jb_node);
-            ObString key;
-            if (OB_FAIL(bin_agg.append_key_and_value(key, value, j_node))) {
-              LOG_WARN("failed to append key and value", K(ret));
-            }
-          }
+        j_node = static_cast<ObJsonBin *>(jb_node);
+        ObString key;
+        if (OB_FAIL(bin_agg.append_key_and_value(key, value, j_node))) {
+          LOG_WARN("failed to append key and value", K(ret));
         }
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(bin_agg.serialize())) {
+      LOG_WARN("failed to serialize bin agg.", K(ret));
+    } else if (OB_FAIL(bin_agg.get_buffer()->get_result_string(res_str))) {
+      LOG_WARN("failed to get result string.", K(ret));
+    }
+  }
+  return ret;
+}
 
-        if (OB_FAIL(ret)) {
-        } else if (OB_FAIL(bin_agg.serialize())) {
-          LOG_WARN("failed to serialize bin agg.", K(ret));
-        } else if (OB_FAIL(ObJsonExprHelper::pack_json_str_res(expr, ctx, res, bin_agg.get_buffer()->string()))) {
-          LOG_WARN("failed to pack json res.", K(ret));
+template <typename JsonVec, typename ResVec>
+int ObExprJsonExtract::vector_json_extract(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  const JsonVec *json_vec = static_cast<const JsonVec *>(expr.args_[0]->get_vector(ctx));
+  ObIVector *path_vec = expr.args_[1]->get_vector(ctx);
+  ResVec *res_vec = static_cast<ResVec *>(expr.get_vector(ctx));
+  ObBitVector &eval_flags = expr.get_evaluated_flags(ctx);
+  ObEvalCtx::TempAllocGuard tmp_alloc_g(ctx);
+  common::ObArenaAllocator &allocator = tmp_alloc_g.get_allocator();
+  // memory of one document is released after the row is done, outrow json may be large
+  common::ObArenaAllocator row_allocator(ObModIds::OB_LOB_READER, OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID());
+  ObJsonPath *j_path = NULL;
+  ObJsonPathCache ctx_cache(&allocator);
+  ObJsonPathCache* path_cache = ObJsonExprHelper::get_path_cache_ctx(expr.expr_ctx_id_, &ctx.exec_ctx_);
+  path_cache = ((path_cache != NULL) ? path_cache : &ctx_cache);
+  bool is_null_path = path_vec->is_null(bound.start());
+  bool may_match_many = false;
+  for (int64_t i = bound.start(); OB_SUCC(ret) && i < bound.end(); i++) {
+    if (skip.at(i) || eval_flags.at(i)) {
+      continue;
+    } else if (is_null_path || json_vec->is_null(i)) {
+      res_vec->set_null(i);
+    } else {
+      ObString j_str;
+      ObIJsonBase *j_base = NULL;
+      ObJsonSeekResult hit;
+      ObJsonBin res_json(&row_allocator);
+      ObString res_str;
+      hit.res_point_ = &res_json;
+      // the path is const within the batch, it is parsed (or found in cache) only once, and not
+      // before the first non-null document, the same as the row path.
+      if (OB_ISNULL(j_path)) {
+        ObString path_text;
+        if (OB_FAIL(ObTextStringHelper::get_string(expr, allocator, 1, i, path_vec, path_text))) {
+          LOG_WARN("fail to get real data.", K(ret), K(path_text));
+        } else if (OB_FAIL(ObJsonExprHelper::find_and_add_cache(path_cache, j_path, path_text, 1, true))) {
+          LOG_WARN("parse text to path failed", K(path_text), K(ret));
+        } else {
+          may_match_many = j_path->can_match_many();
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(ObTextStringHelper::get_string(expr, row_allocator, 0, i, json_vec, j_str))) {
+        LOG_WARN("fail to get real data.", K(ret), K(j_str));
+      } else if (OB_FAIL(ObJsonBaseFactory::get_json_base(&row_allocator, j_str, ObJsonInType::JSON_BIN,
+                                                          ObJsonInType::JSON_BIN, j_base, 0,
+                                                          ObJsonExprHelper::get_json_max_depth_config()))) {
+        LOG_WARN("fail to get json base", K(ret));
+        ret = OB_ERR_INVALID_JSON_TEXT_IN_PARAM;
+        LOG_USER_ERROR(OB_ERR_INVALID_JSON_TEXT_IN_PARAM);
+      } else if (OB_FAIL(j_base->seek(*j_path, j_path->path_node_cnt(), true, false, hit))) {
+        LOG_WARN("json seek failed", K(ret));
+      } else if (hit.size() == 0) {
+        res_vec->set_null(i);
+      } else if (OB_FAIL(get_extract_result(row_allocator, hit, may_match_many, res_str))) {
+        LOG_WARN("json extarct get results failed", K(ret));
+      } else {
+        ObTextStringVectorResult<ResVec> text_res(expr.datum_meta_.type_, &expr, &ctx, res_vec, i);
+        if (OB_FAIL(text_res.init_with_batch_idx(res_str.length(), i))) {
+          LOG_WARN("init lob result failed", K(ret), K(res_str.length()));
+        } else if (OB_FAIL(text_res.append(res_str.ptr(), res_str.length()))) {
+          LOG_WARN("failed to append realdata", K(ret), K(res_str));
+        } else {
+          text_res.set_result();
         }
       }
     }
-  } else if (OB_SUCC(ret) && is_null_result) {
-    res.set_null();
+    row_allocator.reset_remain_one_page();
+    if (OB_SUCC(ret)) {
+      eval_flags.set(i);
+    }
   }
+  return ret;
+}
 
+int ObExprJsonExtract::eval_json_extract_vector(VECTOR_EVAL_FUNC_ARG_DECL)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(skip.accumulate_bit_cnt(bound) == bound.range_size())) {
+    // do nothing
+  } else if (expr.datum_meta_.cs_type_ != CS_TYPE_UTF8MB4_BIN) {
+    ret = OB_ERR_INVALID_JSON_CHARSET;
+    LOG_WARN("invalid out put charset", K(ret), K(expr.datum_meta_.cs_type_));
+  } else if (OB_FAIL(expr.eval_vector_param_value(ctx, skip, bound))) {
+    LOG_WARN("evaluate parameters failed", K(ret));
+  } else {
+    VectorFormat arg_format = expr.args_[0]->get_format(ctx);
+    VectorFormat res_format = expr.get_format(ctx);
+    if (VEC_DISCRETE == arg_format && VEC_DISCRETE == res_format) {
+      ret = vector_json_extract<JsonDiscVec, JsonDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST);
+    } else if (VEC_UNIFORM == arg_format && VEC_DISCRETE == res_format) {
+      ret = vector_json_extract<JsonUniVec, JsonDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST);
+    } else if (VEC_CONTINUOUS == arg_format && VEC_DISCRETE == res_format) {
+      ret = vector_json_extract<JsonContVec, JsonDiscVec>(VECTOR_EVAL_FUNC_ARG_LIST);
+    } else {
+      ret = vector_json_extract<ObVectorBase, ObVectorBase>(VECTOR_EVAL_FUNC_ARG_LIST);
+    }
+  }
   return ret;
 }
 
@@ -235,6 +340,13 @@ int ObExprJsonExtract::cg_expr(ObExprCGCtx &expr_cg_ctx, const ObRawExpr &raw_ex
       rt_expr.eval_func_ = eval_json_extract_null;
   } else {
       rt_expr.eval_func_ = eval_json_extract;
+      // json column with one const path, the path is resolved once for each batch
+      if (rt_expr.arg_cnt_ == 2
+          && rt_expr.args_[0]->datum_meta_.type_ == ObJsonType
+          && rt_expr.args_[0]->is_batch_result()
+          && !rt_expr.args_[1]->is_batch_result()) {
+        rt_expr.eval_vector_func_ = eval_json_extract_vector;
+      }
   }
   return OB_SUCCESS;
 }
@@ -15,6 +15,7 @@
 #define OCEANBASE_SQL_OB_EXPR_JSON_EXTRACT_H_
 
 #include "sql/engine/expr/ob_expr_operator.h"
+#include "lib/json_type/ob_json_base.h"
 
 using namespace oceanbase::common;
 
@@ -34,11 +35,16 @@ public:
                                 common::ObExprTypeCtx& type_ctx) const override;
   static int eval_json_extract(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res);
   static int eval_json_extract_null(const ObExpr &expr, ObEvalCtx &ctx, ObDatum &res);
+  static int eval_json_extract_vector(VECTOR_EVAL_FUNC_ARG_DECL);
   virtual int cg_expr(ObExprCGCtx &expr_cg_ctx,
                       const ObRawExpr &raw_expr,
                       ObExpr &rt_expr) const override;
   virtual bool need_rt_ctx() const override { return true; }
   private:
+    static int get_extract_result(common::ObIAllocator &allocator, ObJsonSeekResult &hits,
+                                  const bool may_match_many, common::ObString &res_str);
+    template <typename JsonVec, typename ResVec>
+    static int vector_json_extract(VECTOR_EVAL_FUNC_ARG_DECL);
     DISALLOW_COPY_AND_ASSIGN(ObExprJsonExtract);
 };
 
@@ -3320,7 +3320,9 @@ bool ObWindowFunctionVecOp::all_supported_winfuncs(const ObIArray<ObWinFunRawExp
   for (int i = 0; ret && i < win_exprs.count(); i++) {
     ObWinFunRawExpr *win_expr = win_exprs.at(i);
     if (win_expr->get_agg_expr() != nullptr) {
+      // roaringbitmap aggregates keep live bitmaps outside the agg row, not supported in window
       ret = aggregate::supported_aggregate_function(win_expr->get_func_type())
+            && !aggregate::Processor::is_rb_aggregate(win_expr->get_func_type())
             && !win_expr->get_agg_expr()->is_param_distinct();
     }
   }
@@ -18,6 +18,7 @@
 #include "storage/blocksstable/index_block/ob_index_block_builder.h"
 #include "storage/tablet/ob_tablet_common.h"
 #include "storage/tx_storage/ob_ls_service.h"
+#include "storage/tx_storage/ob_tenant_freezer.h"
 #include "storage/compaction/ob_partition_merge_progress.h"
 #include "ob_tenant_compaction_progress.h"
 #include "ob_compaction_diagnose.h"
@@ -1003,6 +1004,21 @@ int ObTabletMergeFinishTask::report_checkpoint_diagnose_info(ObTabletMergeCtx &c
   return ret;
 }
 
+void ObTabletMergeFinishTask::report_dump_event(ObTabletMergeCtx &ctx)
+{
+  int64_t dump_size = 0;
+  storage::ObTablesHandleArray &tables_handle = ctx.static_param_.tables_handle_;
+  for (int64_t i = 0; i < tables_handle.get_count(); i++) {
+    ObITable *table = tables_handle.get_table(i);
+    if (OB_NOT_NULL(table) && table->is_data_memtable()) {
+      dump_size += static_cast<ObMemtable *>(table)->get_occupied_size();
+    }
+  }
+  if (dump_size > 0) {
+    MTL(ObTenantFreezer *)->add_dump_event(dump_size);
+  }
+}
+
 int ObTabletMergeFinishTask::process()
 {
   int ret = OB_SUCCESS;
@@ -1033,9 +1049,12 @@ int ObTabletMergeFinishTask::process()
   }
 
   if (OB_FAIL(ret)) {
-  } else if (is_mini_merge(ctx_ptr->static_param_.get_merge_type())
-      && OB_TMP_FAIL(report_checkpoint_diagnose_info(*ctx_ptr))) {
-    LOG_WARN("failed to report_checkpoint_diagnose_info", K(tmp_ret), KPC(ctx_ptr));
+  } else if (!is_mini_merge(ctx_ptr->static_param_.get_merge_type())) {
+  } else {
+    if (OB_TMP_FAIL(report_checkpoint_diagnose_info(*ctx_ptr))) {
+      LOG_WARN("failed to report_checkpoint_diagnose_info", K(tmp_ret), KPC(ctx_ptr));
+    }
+    (void)report_dump_event(*ctx_ptr);
   }
 
   return ret;
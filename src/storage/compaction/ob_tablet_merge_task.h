@@ -155,6 +155,7 @@ public:
   virtual ~ObTabletMergeFinishTask();
   int init();
   int report_checkpoint_diagnose_info(ObTabletMergeCtx &ctx);
+  void report_dump_event(ObTabletMergeCtx &ctx);
   virtual int process() override;
 private:
   bool is_inited_;
@@ -140,7 +140,10 @@ int ObStorageHAMacroBlockWriter::process(
   ObStorageObjectOpt opt;
   blocksstable::ObDatumRow macro_meta_row;
   blocksstable::ObStorageObjectWriteInfo write_info;
-  blocksstable::ObStorageObjectHandle write_handle;
+  // the io layer copies the data into its own buffer when the write is submitted, so the next macro block
+  // can be fetched and checked while the previous writes are still in flight.
+  blocksstable::ObStorageObjectHandle write_handles[MAX_INFLIGHT_WRITE_CNT];
+  int64_t write_handle_idx = 0;
   ObICopyMacroBlockReader::CopyMacroBlockReadData read_data;
   copied_ctx.reset();
   int64_t write_count = 0;
@@ -212,6 +215,7 @@ int ObStorageHAMacroBlockWriter::process(
       } else if (read_data.is_macro_data()) {
         ObBufferReader data = read_data.macro_data_;
         MacroBlockId macro_block_id = read_data.macro_block_id_;
+        blocksstable::ObStorageObjectHandle &write_handle = write_handles[write_handle_idx % MAX_INFLIGHT_WRITE_CNT];
 
         if (OB_FAIL(check_macro_block_(data))) {
           STORAGE_LOG(WARN, "failed to check macro block, fatal error", K(ret), K(write_count), K(data));
@@ -224,6 +228,7 @@ int ObStorageHAMacroBlockWriter::process(
           LOG_WARN("failed to write macro block", K(ret), K(opt), K(macro_block_id));
         } else {
           ObTaskController::get().allow_next_syslog();
+          ++write_handle_idx;
           ++write_count;
           write_size += data.capacity();
           LOG_INFO("success copy macro block", K(write_count));
@@ -234,12 +239,14 @@ int ObStorageHAMacroBlockWriter::process(
       }
     }
 
-    if (!write_handle.is_empty()) {
-      int tmp_ret = write_handle.wait();
-      if (OB_SUCCESS != tmp_ret) {
-        LOG_WARN("failed to wait write handle", K(ret), K(tmp_ret), K(write_info));
-        if (OB_SUCC(ret)) {
-          ret = tmp_ret;
+    for (int64_t i = 0; i < MAX_INFLIGHT_WRITE_CNT; ++i) {
+      if (!write_handles[i].is_empty()) {
+        int tmp_ret = write_handles[i].wait();
+        if (OB_SUCCESS != tmp_ret) {
+          LOG_WARN("failed to wait write handle", K(ret), K(tmp_ret), K(i), K(write_info));
+          if (OB_SUCC(ret)) {
+            ret = tmp_ret;
+          }
         }
       }
     }
@@ -82,6 +82,8 @@ private:
       blocksstable::ObBufferReader &data);
 
 protected:
+  static const int64_t MAX_INFLIGHT_WRITE_CNT = 4;
+
   bool is_inited_;
   uint64_t tenant_id_;
   share::ObLSID ls_id_;
@@ -2516,12 +2516,22 @@ int ObTenantMetaMemMgr::get_wash_tablet_candidate(const std::type_info &type_inf
     STORAGE_LOG(WARN, "not supported to wash", K(ret), "type:", type_info.name());
   }
   if (OB_SUCC(ret)) {
+    // The buffer list works as a clock: the scanned tablets which are still hot or held by others are moved
+    // to the tail, so the cold tablets gather at the head and the candidate is found without a full scan.
     CandidateTabletInfo min;
     min.wash_score_ = INT64_MAX;
+    const int64_t total_cnt = header->get_size();
+    const int64_t current_time_ns = ObTimeUtility::current_time_ns();
+    int64_t scan_cnt = 0;
+    ObMetaObjBufferNode *next = nullptr;
     for (curr = header->get_first();
-         OB_SUCC(ret) && curr != header->get_header() && curr != nullptr;
-         curr = curr->get_next()) {
-      if (curr->get_data().has_new_) {
+         OB_SUCC(ret) && curr != header->get_header() && curr != nullptr && scan_cnt < total_cnt;
+         curr = next, ++scan_cnt) {
+      next = curr->get_next();
+      bool is_hot = true;
+      if (min.is_valid() && scan_cnt >= MAX_WASH_CANDIDATE_SCAN_CNT) {
+        break;
+      } else if (curr->get_data().has_new_) {
         ObTablet *tablet = reinterpret_cast<ObTablet *>(ObMetaObjBufferHelper::get_obj_buffer(curr));
         const ObTabletMeta &tablet_meta = tablet->get_tablet_meta();
         const ObTabletMapKey tablet_key(tablet_meta.ls_id_, tablet_meta.tablet_id_);
@@ -2537,14 +2547,19 @@ int ObTenantMetaMemMgr::get_wash_tablet_candidate(const std::type_info &type_inf
           if (need_skip) {
             // just skip, nothing to do.
           } else if (candidate.wash_score_ < 0
-              || (candidate.wash_score_ > 0 && (ObTimeUtility::current_time_ns() - candidate.wash_score_ > 1000000000))) {
+              || (candidate.wash_score_ > 0 && (current_time_ns - candidate.wash_score_ > 1000000000))) {
             info = candidate;
             break;
           } else if (candidate.wash_score_ < min.wash_score_) {
             min = candidate;
+            is_hot = false;
           }
         }
       }
+      if (is_hot && next != header->get_header()) {
+        // give the hot tablet a second chance, it will be checked again after the others.
+        (void) header->move_to_last(curr);
+      }
     }
     if (OB_SUCC(ret)) {
       if (info.is_valid()) {
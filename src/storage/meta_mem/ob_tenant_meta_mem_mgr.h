@@ -485,6 +485,7 @@ private:
   static const int64_t SSTABLE_GC_MAX_TIME = 500; // 500us
   static const int64_t LEAK_CHECKER_CONFIG_REFRESH_TIMEOUT = 10000000 * 10; // 10s
   static const int64_t FLYING_TABLET_THRESHOLD = 100000;
+  static const int64_t MAX_WASH_CANDIDATE_SCAN_CNT = 4096; // stop scanning once a candidate is found after this
   typedef common::ObBinaryHeap<CandidateTabletInfo, HeapCompare, DEFAULT_TABLET_WASH_HEAP_COUNT> Heap;
   typedef common::ObDList<ObMetaObjBufferNode> TabletBufferList;
   typedef common::hash::ObHashSet<MinMinorSSTableInfo, common::hash::NoPthreadDefendMode> SSTableSet;
@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX STORAGE
 
 #include "storage/ob_storage_table_guard.h"
+#include "observer/omt/ob_tenant.h"
 #include "share/allocator/ob_shared_memory_allocator_mgr.h"
 #include "share/throttle/ob_throttle_common.h"
 #include "share/throttle/ob_share_throttle_define.h"
@@ -49,6 +50,7 @@ ObStorageTableGuard::ObStorageTableGuard(
 {
   init_ts_ = ObClockGenerator::getClock();
   share::memstore_throttled_alloc() = 0;
+  share::memstore_smooth_throttle_alloc() = 0;
 }
 
 ObStorageTableGuard::~ObStorageTableGuard()
@@ -56,6 +58,7 @@ ObStorageTableGuard::~ObStorageTableGuard()
   (void)throttle_if_needed_();
   reset();
   share::memstore_throttled_alloc() = 0;
+  share::memstore_smooth_throttle_alloc() = 0;
 }
 
 void ObStorageTableGuard::throttle_if_needed_()
@@ -99,8 +102,76 @@ void ObStorageTableGuard::throttle_if_needed_()
           module_ti_guard.throttle_info()->reset();
         }
       }
+    } else {
+      (void)smooth_throttle_if_needed_();
+    }
+  }
+}
+
+void ObStorageTableGuard::smooth_throttle_if_needed_()
+{
+  const int64_t alloc_size = share::memstore_smooth_throttle_alloc();
+  if (alloc_size <= 0 || for_replay_) {
+    // the smooth throttle only slows down the leader writes, replay is controlled by the pending log size
+  } else if (OB_NOT_NULL(memtable_) && memtable_->is_active_memtable()) {
+    // tokens are only charged here, where the writer really waits for them
+    ObThrottleTokenBucket &bucket = MTL(ObSharedMemAllocMgr *)->memstore_allocator().smooth_throttle_bucket();
+    const int64_t current_ts = ObClockGenerator::getClock();
+    const int64_t throttle_time = bucket.consume(alloc_size, current_ts);
+    const int64_t remain_time = store_ctx_.timeout_ - current_ts;
+    const int64_t expected_sleep_time = MAX(0, MIN(MIN(throttle_time, MAX_SMOOTH_THROTTLE_TIME), remain_time));
+    int64_t sleep_time = 0;
+    if (expected_sleep_time > 0) {
+      // release the memtable before sleeping so that it will not block the freeze
+      const ObLSID ls_id = tablet_->get_tablet_meta().ls_id_;
+      reset();
+      sleep_time = smooth_throttle_sleep_(ls_id, expected_sleep_time);
+    }
+    if (sleep_time < throttle_time) {
+      // the sleep is cut by the cap, the timeout or an exit condition, the following writers should
+      // not pay for it
+      bucket.refund(throttle_time - sleep_time);
+    }
+    if (throttle_time > 0 && REACH_TIME_INTERVAL(LOG_INTERVAL_US)) {
+      LOG_INFO("[Throttle] smooth throttle memstore write", K(alloc_size), K(throttle_time),
+               K(expected_sleep_time), K(sleep_time), KPC(this));
+    }
+  }
+  share::memstore_smooth_throttle_alloc() = 0;
+}
+
+// sleep in slices as TxShareMemThrottleUtil::do_throttle does, and stop early if the ls is offline,
+// the tenant is stopped or the write times out. Return the time really slept.
+int64_t ObStorageTableGuard::smooth_throttle_sleep_(const ObLSID &ls_id, const int64_t expected_sleep_time)
+{
+  int ret = OB_SUCCESS;
+  int64_t sleep_time = 0;
+  ObLSHandle ls_handle;
+  ObLS *ls = nullptr;
+  omt::ObTenant *tenant = static_cast<omt::ObTenant *>(MTL_CTX());
+  if (OB_FAIL(MTL(ObLSService *)->get_ls(ls_id, ls_handle, ObLSGetMod::STORAGE_MOD))) {
+    LOG_WARN("get ls handle failed", KR(ret), K(ls_id));
+  } else if (OB_ISNULL(ls = ls_handle.get_ls())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("ls is null", KR(ret), K(ls_id));
+  } else {
+    uint64_t timeout = 10000;  // 10s
+    common::ObWaitEventGuard wait_guard(
+        common::ObWaitEventIds::MEMSTORE_MEM_PAGE_ALLOC_WAIT, timeout, 0, 0, expected_sleep_time);
+    while (sleep_time < expected_sleep_time) {
+      if (ls->is_offline()
+          || (OB_NOT_NULL(tenant) && tenant->has_stopped())
+          || ObClockGenerator::getClock() >= store_ctx_.timeout_) {
+        break;
+      } else {
+        const int64_t sleep_interval = MIN(SLEEP_INTERVAL_PER_TIME, expected_sleep_time - sleep_time);
+        ::usleep(sleep_interval);
+        sleep_time += sleep_interval;
+      }
     }
+    EVENT_ADD(ObStatEventIds::STORAGE_WRITING_THROTTLE_TIME, sleep_time);
   }
+  return sleep_time;
 }
 
 int ObStorageTableGuard::refresh_and_protect_memtable_for_write(ObRelativeTable &relative_table)
@@ -82,6 +82,8 @@ private:
   bool need_to_refresh_table(ObTableStoreIterator &iter);
   void check_if_need_log_(bool &need_log, bool &need_log_error);
   void throttle_if_needed_();
+  void smooth_throttle_if_needed_();
+  int64_t smooth_throttle_sleep_(const share::ObLSID &ls_id, const int64_t expected_sleep_time);
   int double_check_get_memtable_for_replay_(const share::SCN replay_scn,
                                             bool &need_retry);
 
@@ -90,6 +92,7 @@ private:
   static const int64_t LOG_ERROR_INTERVAL_US = 60 * 1000 * 1000;  // 1min
   static const int64_t GET_TS_INTERVAL = 10 * 1000;
   static const int64_t SLEEP_INTERVAL_PER_TIME = 20 * 1000; // 20ms
+  static const int64_t MAX_SMOOTH_THROTTLE_TIME = 1000 * 1000; // 1s
 
   ObTablet *tablet_;
   ObStoreCtx &store_ctx_;
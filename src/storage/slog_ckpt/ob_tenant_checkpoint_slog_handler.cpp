@@ -182,6 +182,7 @@ ObTenantCheckpointSlogHandler::ObTenantCheckpointSlogHandler()
     tg_id_(-1),
     write_ckpt_task_(this),
     replay_tablet_disk_addr_map_(),
+    replay_stat_(),
     super_block_mutex_()
 {
 }
@@ -265,7 +266,13 @@ int ObTenantCheckpointSlogHandler::start_replay(const ObTenantSuperBlock &super_
   } else if (OB_FAIL(replay_checkpoint_and_slog(super_block))) {
     LOG_WARN("fail to read_checkpoint_and_replay_slog", K(ret), K(super_block));
   }
-  LOG_INFO("finish ObTenantCheckpointSlogHandler replay", K(ret), K(super_block));
+  FLOG_INFO("finish ObTenantCheckpointSlogHandler replay", K(ret), K(super_block), K_(replay_stat));
+  SERVER_EVENT_ADD("storage", "replay tenant storage meta", "tenant_id", MTL_ID(), "ret", ret,
+      "tablet_cnt", replay_stat_.tablet_cnt_,
+      "total_cost(us)", replay_stat_.total_cost_us_,
+      "checkpoint_cost(us)", replay_stat_.checkpoint_cost_us_,
+      "slog_cost(us)", replay_stat_.slog_cost_us_,
+      to_cstring(replay_stat_));
 
   return ret;
 }
@@ -275,6 +282,9 @@ int ObTenantCheckpointSlogHandler::replay_checkpoint_and_slog(const ObTenantSupe
   int ret = OB_SUCCESS;
   const ObMemAttr mem_attr(MTL_ID(), "TenantReplay");
   const int64_t replay_tablet_cnt = 10003;
+  const int64_t start_time = ObTimeUtility::current_time();
+  int64_t phase_start_time = start_time;
+  replay_stat_.reset();
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("ObTenantCheckpointSlogHandler not init", K(ret));
@@ -282,13 +292,17 @@ int ObTenantCheckpointSlogHandler::replay_checkpoint_and_slog(const ObTenantSupe
     LOG_WARN("fail to create replay map", K(ret));
   } else if (OB_FAIL(replay_snapshot(super_block))) {
     LOG_WARN("fail to replay snapshot", K(ret), K(super_block));
+  } else if (FALSE_IT(replay_stat_.snapshot_cost_us_ = ObTimeUtility::current_time() - phase_start_time)) {
+  } else if (FALSE_IT(phase_start_time = ObTimeUtility::current_time())) {
   } else if (OB_FAIL(replay_checkpoint(super_block))) {
     LOG_WARN("fail to read_ls_checkpoint", K(ret), K(super_block));
+  } else if (FALSE_IT(replay_stat_.checkpoint_cost_us_ = ObTimeUtility::current_time() - phase_start_time)) {
   } else if (OB_FAIL(replay_tenant_slog(super_block.replay_start_point_))) {
     LOG_WARN("fail to replay_tenant_slog", K(ret), K(super_block));
   } else {
     replay_tablet_disk_addr_map_.destroy();
   }
+  replay_stat_.total_cost_us_ = ObTimeUtility::current_time() - start_time;
   return ret;
 }
 
@@ -553,6 +567,7 @@ int ObTenantCheckpointSlogHandler::replay_tenant_slog(const common::ObLogCursor
   int ret = OB_SUCCESS;
   ObLogCursor replay_finish_point;
   ObStorageLogReplayer replayer;
+  const int64_t start_time = ObTimeUtility::current_time();
   blocksstable::ObLogFileSpec log_file_spec;
   log_file_spec.retry_write_policy_ = "normal";
   log_file_spec.log_create_policy_ = "normal";
@@ -565,12 +580,16 @@ int ObTenantCheckpointSlogHandler::replay_tenant_slog(const common::ObLogCursor
   } else if (OB_FAIL(replayer.replay(start_point, replay_finish_point, MTL_ID()))) {
     LOG_WARN("fail to replay tenant slog", K(ret));
   } else {
+    const int64_t create_start_time = ObTimeUtility::current_time();
+    replay_stat_.slog_cost_us_ = create_start_time - start_time;
+    replay_stat_.tablet_cnt_ = replay_tablet_disk_addr_map_.size();
     ObTabletReplayCreateHandler handler;
     if (OB_FAIL(handler.init(replay_tablet_disk_addr_map_, ObTabletRepalyOperationType::REPLAY_CREATE_TABLET))) {
       LOG_WARN("fail to init ObTabletReplayCreateHandler", K(ret));
     } else if (OB_FAIL(handler.concurrent_replay(GCTX.startup_accel_handler_))) {
       LOG_WARN("fail to concurrent replay tablets", K(ret));
     }
+    replay_stat_.create_tablet_cost_us_ = ObTimeUtility::current_time() - create_start_time;
   }
   if (OB_FAIL(ret)) {
     // do nothing
@@ -65,6 +65,32 @@ public:
   blocksstable::MacroBlockId tablet_meta_entry_;
 };
 
+// the cost of each phase of the tenant storage meta recovery during restart
+struct ObTenantMetaReplayStat final
+{
+public:
+  ObTenantMetaReplayStat() { reset(); }
+  ~ObTenantMetaReplayStat() = default;
+  void reset()
+  {
+    snapshot_cost_us_ = 0;
+    checkpoint_cost_us_ = 0;
+    slog_cost_us_ = 0;
+    create_tablet_cost_us_ = 0;
+    total_cost_us_ = 0;
+    tablet_cnt_ = 0;
+  }
+  TO_STRING_KV(K_(snapshot_cost_us), K_(checkpoint_cost_us), K_(slog_cost_us),
+      K_(create_tablet_cost_us), K_(total_cost_us), K_(tablet_cnt));
+
+  int64_t snapshot_cost_us_;
+  int64_t checkpoint_cost_us_;
+  int64_t slog_cost_us_;
+  int64_t create_tablet_cost_us_;
+  int64_t total_cost_us_;
+  int64_t tablet_cnt_;
+};
+
 class ObTenantCheckpointSlogHandler : public ObIRedoModule
 {
 public:
@@ -132,6 +158,7 @@ public:
   int clone_ls(
       observer::ObStartupAccelTaskHandler* startup_accel_handler,
       const blocksstable::MacroBlockId &tablet_meta_entry);
+  const ObTenantMetaReplayStat &get_replay_stat() const { return replay_stat_; }
 private:
   int clone_tablet(const ObMetaDiskAddr &addr, const char *buf, const int64_t buf_len);
   int get_cur_cursor();
@@ -204,6 +231,7 @@ private:
   int tg_id_;
   ObWriteCheckpointTask write_ckpt_task_;
   ReplayTabletDiskAddrMap replay_tablet_disk_addr_map_;
+  ObTenantMetaReplayStat replay_stat_;
   lib::ObMutex super_block_mutex_;
 };
 
@@ -701,8 +701,12 @@ int ObTxReplayExecutor::replay_one_row_in_memtable_(ObMutatorRowHeader &row_head
   int ret = OB_SUCCESS;
   lib::Worker::CompatMode mode;
   ObTabletHandle tablet_handle;
+  ObTablet *tablet = nullptr;
   const bool is_update_mds_table = false;
-  if (OB_FAIL(ls_->replay_get_tablet(row_head.tablet_id_, log_ts_ns_, is_update_mds_table, tablet_handle))) {
+  if (row_head.tablet_id_ == cached_tablet_id_ && cached_tablet_handle_.is_valid()) {
+    // the tablet has been checked by the previous row of this log
+    tablet = cached_tablet_handle_.get_obj();
+  } else if (OB_FAIL(ls_->replay_get_tablet(row_head.tablet_id_, log_ts_ns_, is_update_mds_table, tablet_handle))) {
     if (OB_OBSOLETE_CLOG_NEED_SKIP == ret) {
       ctx_->force_no_need_replay_checksum(!is_tx_log_replay_queue(), log_ts_ns_);
       ret = OB_SUCCESS;
@@ -727,10 +731,17 @@ int ObTxReplayExecutor::replay_one_row_in_memtable_(ObMutatorRowHeader &row_head
     } else {
       TX_REPLAY_LOG(WARN, "replay check restore status error", K(row_head.tablet_id_));
     }
+  } else {
+    tablet = tablet_handle.get_obj();
+    cached_tablet_id_ = row_head.tablet_id_;
+    cached_tablet_handle_ = tablet_handle;
+  }
+
+  if (OB_FAIL(ret) || OB_ISNULL(tablet)) {
+    // the row is skipped or need retry
   } else if (OB_FAIL(get_compat_mode_(row_head.tablet_id_, mode))) {
     TX_REPLAY_LOG(WARN, "get compat mode error", K(mode));
   } else {
-    ObTablet *tablet = tablet_handle.get_obj();
     storage::ObStoreCtx storeCtx;
     storeCtx.ls_id_ = ctx_->get_ls_id();
     storeCtx.mvcc_acc_ctx_.init_replay(
@@ -18,6 +18,7 @@
 
 #include "lib/worker.h"
 #include "storage/ob_storage_table_guard.h"
+#include "storage/meta_mem/ob_tablet_handle.h"
 
 namespace oceanbase
 {
@@ -98,6 +99,8 @@ private:
         tx_part_log_no_(0),
         mvcc_row_count_(0),
         table_lock_row_count_(0),
+        cached_tablet_id_(),
+        cached_tablet_handle_(),
         base_header_(base_header)
   {}
 
@@ -169,6 +172,10 @@ private:
   // memtable::ObMemtable * mem_store_;
   int64_t mvcc_row_count_;
   int64_t table_lock_row_count_;
+  // the rows of the same tablet are usually adjacent in the mutator, so the tablet which has
+  // passed the replay check is cached and shared by the following rows of this log.
+  common::ObTabletID cached_tablet_id_;
+  storage::ObTabletHandle cached_tablet_handle_;
   const logservice::ObLogBaseHeader &base_header_;
 };
 }
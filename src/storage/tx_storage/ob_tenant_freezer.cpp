@@ -48,6 +48,7 @@ ObTenantFreezer::ObTenantFreezer()
     freeze_thread_pool_lock_(common::ObLatchIds::FREEZE_THREAD_POOL_LOCK),
     freezer_stat_(),
     freezer_history_(),
+    memstore_speed_estimator_(),
     throttle_is_skipping_cache_(),
     memstore_remain_memory_is_exhausting_cache_()
 {
@@ -69,6 +70,7 @@ void ObTenantFreezer::destroy()
   rs_mgr_ = nullptr;
   freezer_stat_.reset();
   freezer_history_.reset();
+  memstore_speed_estimator_.reset();
   throttle_is_skipping_cache_.reset();
   memstore_remain_memory_is_exhausting_cache_.reset();
 
@@ -525,7 +527,11 @@ int ObTenantFreezer::check_and_freeze_normal_data_(ObTenantFreezeCtx &ctx)
     } else if (OB_FAIL(get_tenant_mem_usage_(ctx))) {
       LOG_WARN("[TenantFreezer] fail to get mem usage", KR(ret));
     } else {
+      ObMemstoreAllocator &tenant_allocator = MTL(ObSharedMemAllocMgr *)->memstore_allocator();
+      memstore_speed_estimator_.sample(tenant_allocator.get_memstore_allocated_pos(),
+                                       ObClockGenerator::getClock());
       need_freeze = need_freeze_(ctx);
+      update_smooth_throttle_(ctx);
       log_frozen_memstore_info_if_need_(ctx);
       halt_prewarm_if_need_(ctx);
     }
@@ -1243,6 +1249,7 @@ int ObTenantFreezer::get_freeze_trigger_(ObTenantFreezeCtx &ctx)
   // result
   ctx.max_mem_memstore_can_get_now_ = max_mem_memstore_can_get_now;
   ctx.memstore_freeze_trigger_ = memstore_freeze_trigger;
+  ctx.memstore_throttle_trigger_ = mem_memstore_limit / 100 * get_writing_throttling_trigger_percentage_();
 
   return ret;
 }
@@ -1356,6 +1363,27 @@ int64_t ObTenantFreezer::get_freeze_trigger_percentage_()
   return percent;
 }
 
+int64_t ObTenantFreezer::get_writing_throttling_trigger_percentage_()
+{
+  static const int64_t DEFAULT_WRITING_THROTTLING_TRIGGER_PERCENTAGE = 60;
+  int64_t percent = DEFAULT_WRITING_THROTTLING_TRIGGER_PERCENTAGE;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (tenant_config.is_valid()) {
+    percent = tenant_config->writing_throttling_trigger_percentage;
+  }
+  return percent;
+}
+
+bool ObTenantFreezer::is_predictive_freeze_enabled_()
+{
+  bool enabled = false;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (tenant_config.is_valid()) {
+    enabled = tenant_config->_enable_memstore_predictive_freeze;
+  }
+  return enabled;
+}
+
 int64_t ObTenantFreezer::get_memstore_limit_percentage_()
 {
   int ret = OB_SUCCESS;
@@ -1549,7 +1577,11 @@ bool ObTenantFreezer::need_freeze_(const ObTenantFreezeCtx &ctx)
   if (ctx.freezable_active_memstore_used_ > ctx.memstore_freeze_trigger_) {
     need_freeze = true;
   }
-  // 2. may be slowed
+  // 2. trigger by the predicted memstore used.
+  if (!need_freeze && need_predictive_freeze_(ctx)) {
+    need_freeze = true;
+  }
+  // 3. may be slowed
   if (need_freeze && tenant_info_.is_freeze_need_slow()) {
     need_freeze = false;
     LOG_INFO("[TenantFreezer] A minor freeze is needed but slowed.",
@@ -1564,6 +1596,71 @@ bool ObTenantFreezer::need_freeze_(const ObTenantFreezeCtx &ctx)
   return need_freeze;
 }
 
+bool ObTenantFreezer::need_predictive_freeze_(const ObTenantFreezeCtx &ctx)
+{
+  // the active memstore smaller than this percentage of freeze trigger is not worth to be frozen in advance,
+  // otherwise we will generate too many small sstables.
+  static const int64_t MIN_PREDICTIVE_FREEZE_PERCENTAGE = 25;
+  bool need_freeze = false;
+  if (!is_predictive_freeze_enabled_()) {
+  } else if (ctx.freezable_active_memstore_used_ <= ctx.memstore_freeze_trigger_ / 100 * MIN_PREDICTIVE_FREEZE_PERCENTAGE) {
+  } else if (ctx.memstore_throttle_trigger_ <= 0) {
+  } else {
+    // freeze now if the memstore is expected to reach the throttle trigger before
+    // all the memstore in use (include the frozen part) can be dumped.
+    const int64_t fill_time =
+        memstore_speed_estimator_.estimate_fill_time(ctx.memstore_throttle_trigger_ - ctx.total_memstore_used_);
+    const int64_t dump_time = memstore_speed_estimator_.estimate_dump_time(ctx.total_memstore_used_);
+    // the freeze itself also takes some time before the mini merge starts
+    const int64_t expected_dump_time = 0 == dump_time ? 0 : dump_time + FREEZE_TRIGGER_INTERVAL;
+    if (fill_time <= expected_dump_time) {
+      need_freeze = true;
+      LOG_INFO("[TenantFreezer] A minor freeze is needed by predicted memstore used.",
+               K(fill_time), K(expected_dump_time), K(ctx.freezable_active_memstore_used_),
+               K(ctx.total_memstore_used_), K(ctx.memstore_freeze_trigger_),
+               K(ctx.memstore_throttle_trigger_), K_(memstore_speed_estimator));
+    }
+  }
+  return need_freeze;
+}
+
+void ObTenantFreezer::update_smooth_throttle_(const ObTenantFreezeCtx &ctx)
+{
+  // the writes are allowed to consume the remain memory before the throttle trigger within this time
+  static const int64_t SMOOTH_THROTTLE_HORIZON = 30_s;
+  // the smooth throttle will not limit the write speed lower than this
+  static const int64_t MIN_SMOOTH_THROTTLE_RATE = 1LL * 1024LL * 1024LL; // 1MB/s
+  static const int64_t SMOOTH_THROTTLE_BURST_SIZE = 2LL * 1024LL * 1024LL; // 2MB
+  ObMemstoreAllocator &tenant_allocator = MTL(ObSharedMemAllocMgr *)->memstore_allocator();
+  ObThrottleTokenBucket &bucket = tenant_allocator.smooth_throttle_bucket();
+  const int64_t write_speed = memstore_speed_estimator_.get_write_speed();
+  const int64_t dump_speed = memstore_speed_estimator_.get_dump_speed();
+  int64_t rate = 0;
+  if (!is_predictive_freeze_enabled_()
+      || dump_speed <= 0
+      || ctx.total_memstore_used_ <= ctx.memstore_freeze_trigger_) {
+    // no need to limit the write speed before the memstore reaches the freeze trigger
+  } else {
+    // the write speed is allowed to exceed the dump speed by the part which can be absorbed by the remain memory
+    // before the throttle trigger, so the speed is decreased gradually while the memstore is growing.
+    const int64_t remain_size = MAX(0, ctx.memstore_throttle_trigger_ - ctx.total_memstore_used_);
+    const int64_t allowed_rate = MAX(MIN_SMOOTH_THROTTLE_RATE,
+                                     dump_speed + remain_size / (SMOOTH_THROTTLE_HORIZON / 1_s));
+    if (write_speed > allowed_rate) {
+      rate = allowed_rate;
+    }
+  }
+
+  const int64_t old_rate = bucket.get_rate();
+  if (rate != old_rate) {
+    bucket.set_rate(rate, SMOOTH_THROTTLE_BURST_SIZE);
+  }
+  if ((0 == rate) != (0 == old_rate) || (rate > 0 && REACH_TIME_INTERVAL(10_s))) {
+    LOG_INFO("[TenantFreezer] update smooth throttle rate", K(rate), K(old_rate), K(write_speed), K(dump_speed),
+             K(ctx.total_memstore_used_), K(ctx.memstore_freeze_trigger_), K(ctx.memstore_throttle_trigger_));
+  }
+}
+
 bool ObTenantFreezer::is_major_freeze_turn_()
 {
   const int64_t freeze_cnt = tenant_info_.freeze_cnt_;
@@ -239,6 +239,13 @@ public:
     freezer_stat_.add_merge_event(type, cost);
   }
 
+  // record the memtable size dumped by mini merge, which is used to estimate the dump speed
+  void add_dump_event(const int64_t dump_size)
+  {
+    memstore_speed_estimator_.add_dump_event(dump_size);
+  }
+  const ObMemstoreSpeedEstimator &get_memstore_speed_estimator() const { return memstore_speed_estimator_; }
+
   void get_freezer_stat_history_snapshot(int64_t &length);
 
   void get_freezer_stat_from_history(int64_t pos, ObTenantFreezerStat& stat);
@@ -269,6 +276,8 @@ private:
   // @param[in] rollback_freeze_cnt, reduce the tenant's freeze count by 1, if true.
   int unset_tenant_freezing_(const bool rollback_freeze_cnt);
   static int64_t get_freeze_trigger_percentage_();
+  static int64_t get_writing_throttling_trigger_percentage_();
+  static bool is_predictive_freeze_enabled_();
   static int64_t get_memstore_limit_percentage_();
   int post_freeze_request_(const storage::ObFreezeType freeze_type,
                            const int64_t try_frozen_version);
@@ -280,6 +289,8 @@ private:
   int get_tenant_mem_stat_(ObTenantStatistic &stat);
   static int get_freeze_trigger_(ObTenantFreezeCtx &ctx);
   bool need_freeze_(const ObTenantFreezeCtx &ctx);
+  bool need_predictive_freeze_(const ObTenantFreezeCtx &ctx);
+  void update_smooth_throttle_(const ObTenantFreezeCtx &ctx);
   bool is_major_freeze_turn_();
   int do_major_if_need_(const bool need_freeze);
   int do_minor_freeze_data_(const ObTenantFreezeCtx &ctx);
@@ -321,6 +332,8 @@ private:
   ObTenantFreezerStat freezer_stat_;
   // diagnose only, we capture the freeze history in one monthes
   ObTenantFreezerStatHistory freezer_history_;
+  // estimate the memstore write/dump speed for predictive freeze and smooth throttle
+  ObMemstoreSpeedEstimator memstore_speed_estimator_;
   PeriodicalUpdateValueCache throttle_is_skipping_cache_;
   PeriodicalUpdateValueCache memstore_remain_memory_is_exhausting_cache_;
 };
@@ -44,7 +44,8 @@ ObTenantFreezeCtx::ObTenantFreezeCtx()
     freezable_active_memstore_used_(0),
     total_memstore_used_(0),
     total_memstore_hold_(0),
-    max_cached_memstore_size_(0)
+    max_cached_memstore_size_(0),
+    memstore_throttle_trigger_(0)
 {
 }
 
@@ -58,6 +59,7 @@ void ObTenantFreezeCtx::reset()
   total_memstore_used_ = 0;
   total_memstore_hold_ = 0;
   max_cached_memstore_size_ = 0;
+  memstore_throttle_trigger_ = 0;
 }
 
 ObTenantStatistic::ObTenantStatistic()
@@ -91,6 +93,77 @@ void ObTenantStatistic::reset()
   memstore_reclaimed_pos_ = 0;
 }
 
+void ObMemstoreSpeedEstimator::reset()
+{
+  write_speed_ = 0;
+  dump_speed_ = 0;
+  last_sample_ts_ = 0;
+  last_allocated_pos_ = 0;
+  dumped_size_ = 0;
+}
+
+void ObMemstoreSpeedEstimator::add_dump_event(const int64_t dump_size)
+{
+  if (dump_size > 0) {
+    ATOMIC_FAA(&dumped_size_, dump_size);
+  }
+}
+
+int64_t ObMemstoreSpeedEstimator::ewma_(const int64_t old_value, const int64_t new_value)
+{
+  int64_t result = new_value;
+  if (old_value > 0) {
+    result = (new_value * LATEST_SAMPLE_WEIGHT_PERCENTAGE
+              + old_value * (100 - LATEST_SAMPLE_WEIGHT_PERCENTAGE)) / 100;
+  }
+  return result;
+}
+
+void ObMemstoreSpeedEstimator::sample(const int64_t allocated_pos, const int64_t current_ts)
+{
+  // only the freeze trigger thread samples, so there is no concurrent sampling
+  if (0 == last_sample_ts_ || current_ts <= last_sample_ts_) {
+    // the first sample, only record the position
+    ATOMIC_STORE(&dumped_size_, 0);
+  } else {
+    const int64_t interval = current_ts - last_sample_ts_;
+    const int64_t written_size = MAX(0, allocated_pos - last_allocated_pos_);
+    const int64_t dumped_size = ATOMIC_TAS(&dumped_size_, 0);
+    const int64_t write_speed = static_cast<int64_t>(static_cast<double>(written_size) * 1_s / interval);
+    ATOMIC_STORE(&write_speed_, ewma_(write_speed_, write_speed));
+    // there is no dump if nothing is frozen, which does not mean the dump is slow,
+    // so only the intervals with dump activity are sampled.
+    if (dumped_size > 0) {
+      const int64_t dump_speed = static_cast<int64_t>(static_cast<double>(dumped_size) * 1_s / interval);
+      ATOMIC_STORE(&dump_speed_, ewma_(dump_speed_, dump_speed));
+    }
+  }
+  last_sample_ts_ = current_ts;
+  last_allocated_pos_ = allocated_pos;
+}
+
+int64_t ObMemstoreSpeedEstimator::estimate_fill_time(const int64_t remain_size) const
+{
+  int64_t fill_time = INT64_MAX;
+  const int64_t write_speed = get_write_speed();
+  if (remain_size <= 0) {
+    fill_time = 0;
+  } else if (write_speed > 0) {
+    fill_time = static_cast<int64_t>(static_cast<double>(remain_size) * 1_s / write_speed);
+  }
+  return fill_time;
+}
+
+int64_t ObMemstoreSpeedEstimator::estimate_dump_time(const int64_t dump_size) const
+{
+  int64_t dump_time = 0;
+  const int64_t dump_speed = get_dump_speed();
+  if (dump_size > 0 && dump_speed > 0) {
+    dump_time = static_cast<int64_t>(static_cast<double>(dump_size) * 1_s / dump_speed);
+  }
+  return dump_time;
+}
+
 ObTenantInfo::ObTenantInfo()
   :	tenant_id_(INT64_MAX),
     is_loaded_(false),
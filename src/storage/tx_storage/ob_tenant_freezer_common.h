@@ -72,6 +72,8 @@ public:
   int64_t total_memstore_used_;
   int64_t total_memstore_hold_;
   int64_t max_cached_memstore_size_;
+  // the memstore used that the write throttle will be triggered
+  int64_t memstore_throttle_trigger_;
 
 private:
   DISABLE_COPY_ASSIGN(ObTenantFreezeCtx);
@@ -102,6 +104,44 @@ private:
   DISABLE_COPY_ASSIGN(ObTenantStatistic);
 };
 
+// estimate the memstore write speed and the memstore dump speed(by mini merge) of a tenant.
+// it is used to freeze in advance before the memstore reaches the write throttle trigger,
+// and to decide the rate of the smooth write throttle.
+class ObMemstoreSpeedEstimator
+{
+public:
+  // the weight of the latest sample, in percentage
+  static const int64_t LATEST_SAMPLE_WEIGHT_PERCENTAGE = 30;
+public:
+  ObMemstoreSpeedEstimator() { reset(); }
+  ~ObMemstoreSpeedEstimator() { reset(); }
+  void reset();
+  // record the memtable size which has been dumped by a mini merge.
+  void add_dump_event(const int64_t dump_size);
+  // sample the write speed and the dump speed.
+  // @param[in] allocated_pos, the total allocated position of the memstore allocator.
+  // @param[in] current_ts, the sample timestamp.
+  void sample(const int64_t allocated_pos, const int64_t current_ts);
+  // bytes per second, 0 means unknown.
+  int64_t get_write_speed() const { return ATOMIC_LOAD(&write_speed_); }
+  int64_t get_dump_speed() const { return ATOMIC_LOAD(&dump_speed_); }
+  // estimate the time(us) used to write remain_size into memstore, INT64_MAX means never.
+  int64_t estimate_fill_time(const int64_t remain_size) const;
+  // estimate the time(us) used to dump dump_size of memstore, 0 means unknown.
+  int64_t estimate_dump_time(const int64_t dump_size) const;
+  TO_STRING_KV(K_(write_speed), K_(dump_speed), K_(last_sample_ts),
+               K_(last_allocated_pos), K_(dumped_size));
+private:
+  static int64_t ewma_(const int64_t old_value, const int64_t new_value);
+private:
+  int64_t write_speed_;
+  int64_t dump_speed_;
+  int64_t last_sample_ts_;
+  int64_t last_allocated_pos_;
+  // the memtable size dumped since the last sample
+  int64_t dumped_size_;
+};
+
 // store the tenant info, such as memory limit, memstore limit,
 // slow freeze flag, freezing flag and so on.
 class ObTenantInfo : public ObDLinkBase<ObTenantInfo>
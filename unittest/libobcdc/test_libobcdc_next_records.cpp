@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "lib/oblog/ob_log.h"
+#include "libobcdc.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace libobcdc
+{
+// An instance which only implements the single record interface, the batch interface comes
+// from the default implementation of IObCDCInstance.
+class MockCDCInstance : public IObCDCInstance
+{
+public:
+  static const int64_t MAX_RECORD_COUNT = 16;
+  MockCDCInstance() : ready_count_(0), next_idx_(0), fail_at_(-1), released_(), timeouts_() {}
+  virtual ~MockCDCInstance() {}
+  virtual int init(const char *, const uint64_t, ERROR_CALLBACK) override { return OB_SUCCESS; }
+  virtual int init(const std::map<std::string, std::string> &, const uint64_t, ERROR_CALLBACK) override
+  { return OB_SUCCESS; }
+  virtual int init_with_start_tstamp_usec(const std::map<std::string, std::string> &, const uint64_t,
+      ERROR_CALLBACK) override
+  { return OB_SUCCESS; }
+  virtual void destroy() override {}
+  virtual int next_record(ICDCRecord **record, const int64_t timeout_us) override
+  {
+    int ret = OB_SUCCESS;
+    timeouts_.push_back(timeout_us);
+    if (next_idx_ == fail_at_) {
+      ret = OB_ERR_UNEXPECTED;
+    } else if (next_idx_ >= ready_count_) {
+      ret = OB_TIMEOUT;
+    } else {
+      *record = reinterpret_cast<ICDCRecord *>(&records_[next_idx_++]);
+    }
+    return ret;
+  }
+  virtual int next_record(ICDCRecord **record, int32_t &, uint64_t &, const int64_t timeout_us) override
+  {
+    return next_record(record, timeout_us);
+  }
+  virtual void release_record(ICDCRecord *record) override { released_.push_back(record); }
+  virtual int launch() override { return OB_SUCCESS; }
+  virtual void stop() override {}
+  virtual int get_tenant_ids(std::vector<uint64_t> &) override { return OB_SUCCESS; }
+
+  ICDCRecord *record_at(const int64_t idx) { return reinterpret_cast<ICDCRecord *>(&records_[idx]); }
+public:
+  int64_t ready_count_;
+  int64_t next_idx_;
+  int64_t fail_at_;
+  int64_t records_[MAX_RECORD_COUNT];
+  std::vector<ICDCRecord *> released_;
+  std::vector<int64_t> timeouts_;
+};
+
+TEST(IObCDCInstance, next_records)
+{
+  MockCDCInstance instance;
+  ICDCRecord *records[MockCDCInstance::MAX_RECORD_COUNT] = {NULL};
+  int64_t record_count = -1;
+  const int64_t timeout_us = 1000 * 1000;
+
+  EXPECT_EQ(OB_INVALID_ARGUMENT, instance.next_records(NULL, 4, record_count, timeout_us));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, instance.next_records(records, 0, record_count, timeout_us));
+
+  // nothing is ready
+  EXPECT_EQ(OB_TIMEOUT, instance.next_records(records, 4, record_count, timeout_us));
+  EXPECT_EQ(0, record_count);
+  ASSERT_EQ(1, instance.timeouts_.size());
+  EXPECT_EQ(timeout_us, instance.timeouts_[0]);
+
+  // the batch is capped by max_count, only the first record waits
+  instance.timeouts_.clear();
+  instance.ready_count_ = 6;
+  EXPECT_EQ(OB_SUCCESS, instance.next_records(records, 4, record_count, timeout_us));
+  EXPECT_EQ(4, record_count);
+  ASSERT_EQ(4, instance.timeouts_.size());
+  EXPECT_EQ(timeout_us, instance.timeouts_[0]);
+  for (int64_t i = 0; i < record_count; i++) {
+    EXPECT_EQ(instance.record_at(i), records[i]);
+    if (i > 0) {
+      EXPECT_EQ(0, instance.timeouts_[i]);
+    }
+  }
+
+  // the records already queued are drained with timeout 0 after the first one
+  instance.timeouts_.clear();
+  EXPECT_EQ(OB_SUCCESS, instance.next_records(records + 4, 4, record_count, timeout_us));
+  EXPECT_EQ(2, record_count);
+  ASSERT_EQ(3, instance.timeouts_.size());
+  EXPECT_EQ(timeout_us, instance.timeouts_[0]);
+  EXPECT_EQ(0, instance.timeouts_[1]);
+  EXPECT_EQ(0, instance.timeouts_[2]);
+  EXPECT_EQ(instance.record_at(4), records[4]);
+  EXPECT_EQ(instance.record_at(5), records[5]);
+
+  instance.release_records(records, 6);
+  ASSERT_EQ(6, instance.released_.size());
+  for (int64_t i = 0; i < 6; i++) {
+    EXPECT_EQ(instance.record_at(i), instance.released_[i]);
+    EXPECT_EQ(NULL, records[i]);
+  }
+  instance.release_records(NULL, 6);
+  EXPECT_EQ(6, instance.released_.size());
+}
+
+TEST(IObCDCInstance, next_records_fail)
+{
+  MockCDCInstance instance;
+  ICDCRecord *records[MockCDCInstance::MAX_RECORD_COUNT] = {NULL};
+  int64_t record_count = 0;
+  instance.ready_count_ = 8;
+  instance.fail_at_ = 2;
+  // the records fetched before the failure are returned with the error
+  EXPECT_EQ(OB_ERR_UNEXPECTED, instance.next_records(records, 8, record_count, 1000));
+  EXPECT_EQ(2, record_count);
+  EXPECT_EQ(instance.record_at(0), records[0]);
+  EXPECT_EQ(instance.record_at(1), records[1]);
+  instance.release_records(records, record_count);
+  EXPECT_EQ(2, instance.released_.size());
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_libobcdc_next_records.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/oblog/ob_log.h"
+#include "lib/file/file_directory_utils.h"
+#include "ob_log_file_store_service.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace libobcdc
+{
+static const char *TEST_STORE_PATH = "./test_file_store";
+
+bool is_segment_exist(const int64_t cf_id, const int64_t seg_id)
+{
+  char path[256];
+  bool is_exist = false;
+  snprintf(path, sizeof(path), "%s/%ld_%ld.seg", TEST_STORE_PATH, cf_id, seg_id);
+  EXPECT_EQ(OB_SUCCESS, FileDirectoryUtils::is_exists(path, is_exist));
+  return is_exist;
+}
+
+TEST(ObLogFileStoreService, put_get_del)
+{
+  ObLogFileStoreService store;
+  void *cf = NULL;
+  std::string value;
+  int64_t live_data_size = 0;
+  int64_t num_keys = 0;
+  EXPECT_EQ(OB_SUCCESS, store.init(TEST_STORE_PATH));
+  EXPECT_EQ(OB_SUCCESS, store.create_column_family("test_cf", cf));
+
+  EXPECT_EQ(OB_SUCCESS, store.put(cf, "trans_1_0", ObSlice("redo_0", 6)));
+  EXPECT_EQ(OB_SUCCESS, store.put(cf, "trans_1_1", ObSlice("redo_1", 6)));
+  EXPECT_EQ(OB_SUCCESS, store.put(cf, "trans_2_0", ObSlice("redo_2", 6)));
+  EXPECT_EQ(OB_SUCCESS, store.get(cf, "trans_1_1", value));
+  EXPECT_EQ("redo_1", value);
+
+  // overwrite
+  EXPECT_EQ(OB_SUCCESS, store.put(cf, "trans_1_1", ObSlice("redo_1_new", 10)));
+  EXPECT_EQ(OB_SUCCESS, store.get(cf, "trans_1_1", value));
+  EXPECT_EQ("redo_1_new", value);
+  EXPECT_EQ(OB_SUCCESS, store.get_mem_usage(cf, live_data_size, num_keys));
+  EXPECT_EQ(22, live_data_size);
+  EXPECT_EQ(3, num_keys);
+
+  EXPECT_EQ(OB_SUCCESS, store.del(cf, "trans_2_0"));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, store.get(cf, "trans_2_0", value));
+  EXPECT_EQ(OB_SUCCESS, store.del(cf, "trans_2_0"));
+
+  EXPECT_EQ(OB_SUCCESS, store.del_range(cf, "trans_1_", "trans_1_~"));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, store.get(cf, "trans_1_0", value));
+  EXPECT_EQ(OB_SUCCESS, store.get_mem_usage(cf, live_data_size, num_keys));
+  EXPECT_EQ(0, live_data_size);
+  EXPECT_EQ(0, num_keys);
+
+  EXPECT_EQ(OB_SUCCESS, store.drop_column_family(cf));
+  EXPECT_EQ(OB_SUCCESS, store.destory_column_family(cf));
+  store.destroy();
+}
+
+TEST(ObLogFileStoreService, reclaim_segment)
+{
+  ObLogFileStoreService store;
+  void *cf = NULL;
+  std::string value;
+  // larger than half of the default segment size, so each value takes a segment
+  const int64_t value_len = 40L * 1024L * 1024L;
+  std::string big_value(value_len, 'a');
+  EXPECT_EQ(OB_SUCCESS, store.init(TEST_STORE_PATH));
+  EXPECT_EQ(OB_SUCCESS, store.create_column_family("test_cf", cf));
+  // the default column family takes cf_id 0
+  const int64_t cf_id = 1;
+
+  EXPECT_EQ(OB_SUCCESS, store.put(cf, "key_0", ObSlice(big_value.c_str(), value_len)));
+  EXPECT_EQ(OB_SUCCESS, store.put(cf, "key_1", ObSlice(big_value.c_str(), value_len)));
+  EXPECT_TRUE(is_segment_exist(cf_id, 0));
+  EXPECT_TRUE(is_segment_exist(cf_id, 1));
+
+  EXPECT_EQ(OB_SUCCESS, store.get(cf, "key_0", value));
+  EXPECT_EQ(big_value, value);
+
+  // the sealed segment is removed once all values in it are deleted
+  EXPECT_EQ(OB_SUCCESS, store.del(cf, "key_0"));
+  EXPECT_FALSE(is_segment_exist(cf_id, 0));
+  // the segment being written is kept
+  EXPECT_EQ(OB_SUCCESS, store.del(cf, "key_1"));
+  EXPECT_TRUE(is_segment_exist(cf_id, 1));
+
+  EXPECT_EQ(OB_SUCCESS, store.drop_column_family(cf));
+  EXPECT_FALSE(is_segment_exist(cf_id, 1));
+  EXPECT_EQ(OB_SUCCESS, store.destory_column_family(cf));
+  store.destroy();
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_log_file_store_service.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/compress/ob_compressor_pool.h"
+#include "logservice/ob_log_compression.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace logservice;
+
+namespace unittest
+{
+static const int64_t PAYLOAD_LEN = 64 * 1024;
+static const int64_t BUF_LEN = 2 * PAYLOAD_LEN;
+
+class TestLogCompression : public ::testing::Test
+{
+public:
+  virtual void SetUp() override
+  {
+    for (int64_t i = 0; i < PAYLOAD_LEN; ++i) {
+      payload_[i] = static_cast<char>('a' + (i % 7) + (i / 4096));
+    }
+  }
+  // | LogCompressedPayloadHeader | compressed payload |
+  int build_compressed(const ObCompressorType type, int64_t &len)
+  {
+    int ret = OB_SUCCESS;
+    ObCompressor *compressor = NULL;
+    LogCompressedPayloadHeader header(type, PAYLOAD_LEN);
+    int64_t pos = 0;
+    int64_t compressed_len = 0;
+    if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor))) {
+    } else if (OB_FAIL(header.serialize(compressed_, BUF_LEN, pos))) {
+    } else if (OB_FAIL(compressor->compress(payload_, PAYLOAD_LEN, compressed_ + pos,
+                                            BUF_LEN - pos, compressed_len))) {
+    } else {
+      len = pos + compressed_len;
+    }
+    return ret;
+  }
+protected:
+  char payload_[PAYLOAD_LEN];
+  char compressed_[BUF_LEN];
+  char decompressed_[BUF_LEN];
+};
+
+TEST_F(TestLogCompression, header_serialize)
+{
+  char buf[64];
+  int64_t pos = 0;
+  LogCompressedPayloadHeader header(ZSTD_1_3_8_COMPRESSOR, 4096);
+  LogCompressedPayloadHeader invalid_header;
+  ASSERT_TRUE(header.is_valid());
+  ASSERT_FALSE(invalid_header.is_valid());
+  ASSERT_EQ(OB_SUCCESS, header.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(header.get_serialize_size(), pos);
+
+  LogCompressedPayloadHeader header2;
+  int64_t pos2 = 0;
+  ASSERT_EQ(OB_SUCCESS, header2.deserialize(buf, pos, pos2));
+  ASSERT_EQ(pos, pos2);
+  ASSERT_EQ(ZSTD_1_3_8_COMPRESSOR, header2.get_compressor_type());
+  ASSERT_EQ(4096, header2.get_original_len());
+
+  // short buffer
+  pos2 = 0;
+  ASSERT_NE(OB_SUCCESS, header2.deserialize(buf, pos - 1, pos2));
+  // serialize into a short buffer
+  pos2 = 0;
+  ASSERT_NE(OB_SUCCESS, header.serialize(buf, pos - 1, pos2));
+  // bad magic
+  buf[0] = static_cast<char>(~buf[0]);
+  pos2 = 0;
+  ASSERT_EQ(OB_INVALID_DATA, header2.deserialize(buf, pos, pos2));
+  // invalid compressor type
+  LogCompressedPayloadHeader none_header(NONE_COMPRESSOR, 4096);
+  pos = 0;
+  pos2 = 0;
+  ASSERT_EQ(OB_SUCCESS, none_header.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(OB_INVALID_DATA, header2.deserialize(buf, pos, pos2));
+}
+
+TEST_F(TestLogCompression, round_trip)
+{
+  // the compressors which can be chosen by log_storage_compress_func
+  const ObCompressorType types[] = {LZ4_COMPRESSOR, ZSTD_COMPRESSOR, ZSTD_1_3_8_COMPRESSOR};
+  for (int64_t i = 0; i < ARRAYSIZEOF(types); ++i) {
+    int64_t len = 0;
+    int64_t decompressed_len = 0;
+    ASSERT_EQ(OB_SUCCESS, build_compressed(types[i], len));
+    ASSERT_LT(len, PAYLOAD_LEN);
+    ASSERT_EQ(OB_SUCCESS, decompress(compressed_, len, decompressed_, BUF_LEN, decompressed_len));
+    ASSERT_EQ(PAYLOAD_LEN, decompressed_len);
+    ASSERT_EQ(0, MEMCMP(payload_, decompressed_, PAYLOAD_LEN));
+  }
+}
+
+TEST_F(TestLogCompression, corrupt_payload)
+{
+  int64_t len = 0;
+  int64_t decompressed_len = 0;
+  const int64_t header_len = LogCompressedPayloadHeader(LZ4_COMPRESSOR, PAYLOAD_LEN).get_serialize_size();
+  ASSERT_EQ(OB_SUCCESS, build_compressed(LZ4_COMPRESSOR, len));
+  // invalid argument
+  ASSERT_EQ(OB_INVALID_ARGUMENT, decompress(NULL, len, decompressed_, BUF_LEN, decompressed_len));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, decompress(compressed_, 0, decompressed_, BUF_LEN, decompressed_len));
+  // the output buffer is smaller than the original payload
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, decompress(compressed_, len, decompressed_, PAYLOAD_LEN - 1, decompressed_len));
+  // only part of the header
+  ASSERT_NE(OB_SUCCESS, decompress(compressed_, header_len - 1, decompressed_, BUF_LEN, decompressed_len));
+  // truncated compressed payload
+  ASSERT_NE(OB_SUCCESS, decompress(compressed_, len / 2, decompressed_, BUF_LEN, decompressed_len));
+
+  // the original length recorded in header does not match the payload
+  LogCompressedPayloadHeader wrong_len_header(LZ4_COMPRESSOR, PAYLOAD_LEN + 1);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, wrong_len_header.serialize(compressed_, BUF_LEN, pos));
+  ASSERT_EQ(header_len, pos);
+  ASSERT_EQ(OB_INVALID_DATA, decompress(compressed_, len, decompressed_, BUF_LEN, decompressed_len));
+
+  // the header claims a different compressor
+  LogCompressedPayloadHeader wrong_type_header(ZSTD_COMPRESSOR, PAYLOAD_LEN);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, wrong_type_header.serialize(compressed_, BUF_LEN, pos));
+  ASSERT_NE(OB_SUCCESS, decompress(compressed_, len, decompressed_, BUF_LEN, decompressed_len));
+}
+
+TEST_F(TestLogCompression, wrapper_not_init)
+{
+  ObLogCompressorWrapper wrapper;
+  void *compression_buf = NULL;
+  bool compressed = true;
+  const void *final_buf = NULL;
+  int64_t final_nbytes = 0;
+  ASSERT_FALSE(wrapper.is_valid());
+  ASSERT_EQ(OB_INVALID_ARGUMENT, wrapper.init(1, NULL));
+  // the log is appended as is
+  ASSERT_EQ(OB_SUCCESS, wrapper.compress_payload(payload_, PAYLOAD_LEN, compression_buf, compressed,
+                                                 final_buf, final_nbytes));
+  ASSERT_FALSE(compressed);
+  ASSERT_EQ(NULL, compression_buf);
+  ASSERT_EQ(payload_, final_buf);
+  ASSERT_EQ(PAYLOAD_LEN, final_nbytes);
+}
+
+} // end of unittest
+} // end of oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_log_compression.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "logservice/palf/log_define.h"
+#include "logservice/palf/log_reader_utils.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace palf;
+
+namespace unittest
+{
+
+TEST(TestLogReaderUtils, read_window)
+{
+  int64_t pread_size = MAX_LOG_BUFFER_SIZE;
+  // a partial round means the iterator is close to the end of log, keep the window
+  EXPECT_EQ(pread_size, calc_next_round_pread_size(pread_size, pread_size - 1));
+  EXPECT_EQ(pread_size, calc_next_round_pread_size(pread_size, 0));
+
+  // the window is doubled each time it is filled
+  pread_size = calc_next_round_pread_size(pread_size, pread_size);
+  EXPECT_EQ(2 * MAX_LOG_BUFFER_SIZE, pread_size);
+  pread_size = calc_next_round_pread_size(pread_size, pread_size);
+  EXPECT_EQ(4 * MAX_LOG_BUFFER_SIZE, pread_size);
+  EXPECT_EQ(MAX_LOG_READ_AHEAD_SIZE, pread_size);
+
+  // and never exceeds MAX_LOG_READ_AHEAD_SIZE
+  pread_size = calc_next_round_pread_size(pread_size, pread_size);
+  EXPECT_EQ(MAX_LOG_READ_AHEAD_SIZE, pread_size);
+  EXPECT_EQ(MAX_LOG_READ_AHEAD_SIZE, calc_next_round_pread_size(MAX_LOG_READ_AHEAD_SIZE - 1,
+                                                                MAX_LOG_READ_AHEAD_SIZE));
+}
+
+TEST(TestLogReaderUtils, shrink_read_buf)
+{
+  // the size of buffer allocated by alloc_read_buf()
+  auto buf_len_for = [](const int64_t read_size) {
+    return upper_align(read_size, LOG_DIO_ALIGN_SIZE) + LOG_DIO_ALIGN_SIZE + LOG_CACHE_ALIGN_SIZE;
+  };
+  char dummy = 0;
+  ReadBuf invalid_buf;
+  ReadBuf default_buf(&dummy, buf_len_for(MAX_LOG_BUFFER_SIZE));
+  ReadBuf small_buf(&dummy, buf_len_for(LOG_DIO_ALIGN_SIZE));
+  ReadBuf double_buf(&dummy, buf_len_for(2 * MAX_LOG_BUFFER_SIZE));
+  ReadBuf read_ahead_buf(&dummy, buf_len_for(MAX_LOG_READ_AHEAD_SIZE));
+
+  EXPECT_FALSE(need_shrink_read_buf(invalid_buf, MAX_LOG_BUFFER_SIZE));
+  // the buffer for the default window is never shrunk
+  EXPECT_FALSE(need_shrink_read_buf(default_buf, MAX_LOG_BUFFER_SIZE));
+  EXPECT_FALSE(need_shrink_read_buf(default_buf, LOG_DIO_ALIGN_SIZE));
+  EXPECT_FALSE(need_shrink_read_buf(small_buf, LOG_DIO_ALIGN_SIZE));
+  // the enlarged buffer is kept while the window is still enlarged
+  EXPECT_FALSE(need_shrink_read_buf(double_buf, 2 * MAX_LOG_BUFFER_SIZE));
+  EXPECT_FALSE(need_shrink_read_buf(read_ahead_buf, MAX_LOG_BUFFER_SIZE + 1));
+  EXPECT_FALSE(need_shrink_read_buf(read_ahead_buf, MAX_LOG_READ_AHEAD_SIZE));
+  // and is given back once the window is reset
+  EXPECT_TRUE(need_shrink_read_buf(double_buf, MAX_LOG_BUFFER_SIZE));
+  EXPECT_TRUE(need_shrink_read_buf(read_ahead_buf, MAX_LOG_BUFFER_SIZE));
+  EXPECT_TRUE(need_shrink_read_buf(read_ahead_buf, LOG_DIO_ALIGN_SIZE));
+}
+
+} // end of unittest
+} // end of oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_log_reader_utils.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
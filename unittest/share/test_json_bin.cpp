@@ -3389,6 +3389,61 @@ TEST_F(TestJsonBin, test_array_remove_2)
 }
 
 
+static void check_get_bin(ObIAllocator &allocator, const ObString &j_text)
+{
+  ObIJsonBase *j_tree_bin = NULL;
+  ObIJsonBase *j_direct_bin = NULL;
+  ObString raw_bin;
+  ObJsonBuffer tree_buf(&allocator);
+  ObJsonBuffer direct_buf(&allocator);
+  ASSERT_EQ(OB_SUCCESS, ObJsonBaseFactory::get_json_base(&allocator, j_text,
+      ObJsonInType::JSON_TREE, ObJsonInType::JSON_BIN, j_tree_bin));
+  ASSERT_EQ(OB_SUCCESS, ObJsonParser::get_bin(&allocator, j_text, raw_bin));
+  ASSERT_EQ(OB_SUCCESS, ObJsonBaseFactory::get_json_base(&allocator, raw_bin,
+      ObJsonInType::JSON_BIN, ObJsonInType::JSON_BIN, j_direct_bin));
+  ASSERT_EQ(OB_SUCCESS, j_tree_bin->print(tree_buf, true));
+  ASSERT_EQ(OB_SUCCESS, j_direct_bin->print(direct_buf, true));
+  ASSERT_EQ(std::string(tree_buf.ptr(), tree_buf.length()),
+            std::string(direct_buf.ptr(), direct_buf.length()));
+}
+
+TEST_F(TestJsonBin, test_get_bin_from_text)
+{
+  ObArenaAllocator allocator(ObModIds::TEST);
+  const char *texts[] = {
+    "{\"greeting\": 1, \"farewell\": [1, -2, 300, 70000, 5000000000, 18446744073709551615, 1.5, true, false, null],"
+    " \"b\": {\"k\": \"v\", \"empty\": {}, \"arr\": []}}",
+    "{\"k\": 1, \"a\": 2, \"k\": \"dup\", \"\": 3}",
+    "[[], {}, \"\", \"esc\\\"aped\\n\", [[[1]]]]",
+    "\"scalar\"",
+    "123",
+    "-1.25",
+    "null",
+    "true",
+  };
+  for (int64_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+    check_get_bin(allocator, ObString(texts[i]));
+  }
+
+  // large containers need wider entries
+  std::string big_obj = "{";
+  std::string big_arr = "[";
+  for (int64_t i = 0; i < 3000; i++) {
+    std::string idx = std::to_string(i);
+    big_obj += (i == 0 ? "" : ", ") + std::string("\"key_") + idx + "\": [" + idx + ", \"value_" + idx + "\"]";
+    big_arr += (i == 0 ? "" : ", ") + idx + ", -" + idx + "00000";
+  }
+  big_obj += "}";
+  big_arr += "]";
+  check_get_bin(allocator, ObString(big_obj.length(), big_obj.c_str()));
+  check_get_bin(allocator, ObString(big_arr.length(), big_arr.c_str()));
+
+  ObString raw_bin;
+  ASSERT_EQ(OB_ERR_DUPLICATE_KEY, ObJsonParser::get_bin(&allocator, ObString("{\"k\": 1, \"k\": 2}"),
+                                                        raw_bin, ObJsonParser::JSN_UNIQUE_FLAG));
+  ASSERT_EQ(OB_ERR_INVALID_JSON_TEXT, ObJsonParser::get_bin(&allocator, ObString("{\"k\": [1, 2}"), raw_bin));
+}
+
 } // namespace common
 } // namespace oceanbase
 
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "share/throttle/ob_throttle_token_bucket.h"
+#include "storage/tx_storage/ob_tenant_freezer_common.h"
+#undef private
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace storage;
+namespace unittest
+{
+static const int64_t MB = 1024L * 1024L;
+
+TEST(TestThrottleTokenBucket, disabled)
+{
+  ObThrottleTokenBucket bucket;
+  ASSERT_FALSE(bucket.is_limited());
+  ASSERT_EQ(0, bucket.consume(100 * MB, 1000));
+}
+
+TEST(TestThrottleTokenBucket, burst_and_wait)
+{
+  ObThrottleTokenBucket bucket;
+  const int64_t now = 10 * 1000 * 1000;
+  // 10MB/s with 2MB burst
+  bucket.set_rate(10 * MB, 2 * MB);
+  ASSERT_TRUE(bucket.is_limited());
+  // the burst can be consumed without waiting
+  ASSERT_EQ(0, bucket.consume(1 * MB, now));
+  ASSERT_EQ(0, bucket.consume(1 * MB, now));
+  // 1MB exceeds the burst, which needs 100ms to refill
+  ASSERT_EQ(100 * 1000, bucket.consume(1 * MB, now));
+  // the waiting time is accumulated by the following writers
+  ASSERT_EQ(200 * 1000, bucket.consume(1 * MB, now));
+  // the tokens are refilled as time goes by
+  ASSERT_EQ(0, bucket.consume(1 * MB, now + 1000 * 1000));
+  // the unused tokens are dropped and never exceed the burst size
+  ASSERT_EQ(0, bucket.consume(2 * MB, now + 10 * 1000 * 1000));
+  ASSERT_EQ(100 * 1000, bucket.consume(1 * MB, now + 10 * 1000 * 1000));
+
+  bucket.set_rate(0, 2 * MB);
+  ASSERT_EQ(0, bucket.consume(100 * MB, now));
+}
+
+TEST(TestThrottleTokenBucket, refund)
+{
+  ObThrottleTokenBucket bucket;
+  const int64_t now = 10 * 1000 * 1000;
+  bucket.set_rate(10 * MB, 1 * MB);
+  ASSERT_EQ(0, bucket.consume(1 * MB, now));
+  ASSERT_EQ(100 * 1000, bucket.consume(1 * MB, now));
+  // the writer only slept 40ms before its timeout, the rest is given back
+  bucket.refund(60 * 1000);
+  ASSERT_EQ(140 * 1000, bucket.consume(1 * MB, now));
+  bucket.refund(140 * 1000);
+  bucket.refund(0);
+  ASSERT_EQ(100 * 1000, bucket.consume(1 * MB, now));
+}
+
+TEST(TestMemstoreSpeedEstimator, estimate)
+{
+  ObMemstoreSpeedEstimator estimator;
+  int64_t now = 1000 * 1000;
+  ASSERT_EQ(INT64_MAX, estimator.estimate_fill_time(100 * MB));
+  ASSERT_EQ(0, estimator.estimate_dump_time(100 * MB));
+
+  estimator.sample(0, now);
+  now += 1000 * 1000;
+  estimator.add_dump_event(50 * MB);
+  estimator.sample(100 * MB, now);
+  ASSERT_EQ(100 * MB, estimator.get_write_speed());
+  ASSERT_EQ(50 * MB, estimator.get_dump_speed());
+  ASSERT_EQ(1000 * 1000, estimator.estimate_fill_time(100 * MB));
+  ASSERT_EQ(2 * 1000 * 1000, estimator.estimate_dump_time(100 * MB));
+
+  // the interval without dump does not change the dump speed
+  now += 1000 * 1000;
+  estimator.sample(100 * MB, now);
+  ASSERT_EQ(50 * MB, estimator.get_dump_speed());
+  ASSERT_EQ(70 * MB, estimator.get_write_speed());
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_throttle_token_bucket.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SHARE
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <random>
+#include <vector>
+#include "share/vector_type/ob_vector_l2_distance.h"
+#include "share/vector_type/ob_vector_ip_distance.h"
+#include "share/vector_type/ob_vector_cosine_distance.h"
+
+namespace oceanbase
+{
+namespace common
+{
+typedef int (*L2SquareFunc)(const float *a, const float *b, const int64_t len, double &square);
+typedef int (*IpDistanceFunc)(const float *a, const float *b, const int64_t len, double &distance);
+typedef int (*CosineFunc)(const float *a, const float *b, const int64_t len,
+                          double &ip, double &abs_dist_a, double &abs_dist_b);
+
+// the simd kernels which can run on this machine, the first one is the scalar version
+struct DistanceKernels
+{
+  DistanceKernels() : cnt_(0)
+  {
+    add("normal", ObVectorL2Distance::l2_square_normal, ObVectorIpDistance::ip_distance_normal,
+        ObVectorCosineDistance::cosine_calculate_normal);
+#if OB_USE_MULTITARGET_CODE
+    if (is_arch_supported(ObTargetArch::AVX2)) {
+      add("avx2", specific::avx2::l2_square, specific::avx2::ip_distance, specific::avx2::cosine_calculate);
+    }
+    if (is_arch_supported(ObTargetArch::AVX512)) {
+      add("avx512", specific::avx512::l2_square, specific::avx512::ip_distance,
+          specific::avx512::cosine_calculate);
+    }
+#endif
+  }
+  void add(const char *name, L2SquareFunc l2, IpDistanceFunc ip, CosineFunc cosine)
+  {
+    name_[cnt_] = name;
+    l2_[cnt_] = l2;
+    ip_[cnt_] = ip;
+    cosine_[cnt_] = cosine;
+    cnt_++;
+  }
+  int64_t cnt_;
+  const char *name_[3];
+  L2SquareFunc l2_[3];
+  IpDistanceFunc ip_[3];
+  CosineFunc cosine_[3];
+};
+
+class TestVectorDistance : public ::testing::Test
+{
+public:
+  TestVectorDistance() : kernels_() {}
+  virtual ~TestVectorDistance() {}
+  // the simd kernels only change the summation order
+  static void expect_near(const double expected, const double actual, const char *name, const int64_t len)
+  {
+    EXPECT_NEAR(expected, actual, 1e-12 * std::max(1.0, std::fabs(expected)))
+        << "kernel " << name << " len " << len;
+  }
+  void check_equal(const float *a, const float *b, const int64_t len)
+  {
+    double l2[3] = {0};
+    double ip[3] = {0};
+    double cos_ip[3] = {0};
+    double cos_a[3] = {0};
+    double cos_b[3] = {0};
+    for (int64_t k = 0; k < kernels_.cnt_; k++) {
+      ASSERT_EQ(OB_SUCCESS, kernels_.l2_[k](a, b, len, l2[k]));
+      ASSERT_EQ(OB_SUCCESS, kernels_.ip_[k](a, b, len, ip[k]));
+      ASSERT_EQ(OB_SUCCESS, kernels_.cosine_[k](a, b, len, cos_ip[k], cos_a[k], cos_b[k]));
+      expect_near(l2[0], l2[k], kernels_.name_[k], len);
+      expect_near(ip[0], ip[k], kernels_.name_[k], len);
+      expect_near(cos_ip[0], cos_ip[k], kernels_.name_[k], len);
+      expect_near(cos_a[0], cos_a[k], kernels_.name_[k], len);
+      expect_near(cos_b[0], cos_b[k], kernels_.name_[k], len);
+    }
+  }
+  void check_overflow(const float *a, const float *b, const int64_t len)
+  {
+    for (int64_t k = 0; k < kernels_.cnt_; k++) {
+      double l2 = 0;
+      double ip = 0;
+      double cos_ip = 0;
+      double cos_a = 0;
+      double cos_b = 0;
+      EXPECT_EQ(OB_NUMERIC_OVERFLOW, kernels_.ip_[k](a, b, len, ip)) << kernels_.name_[k];
+      EXPECT_EQ(OB_NUMERIC_OVERFLOW, kernels_.cosine_[k](a, b, len, cos_ip, cos_a, cos_b))
+          << kernels_.name_[k];
+      EXPECT_EQ(OB_NUMERIC_OVERFLOW, kernels_.l2_[k](a, b, len, l2)) << kernels_.name_[k];
+    }
+  }
+protected:
+  DistanceKernels kernels_;
+};
+
+TEST_F(TestVectorDistance, normal_and_tail)
+{
+  // lengths which are not a multiple of 8 or 16 go through the scalar tail
+  const int64_t lens[] = {0, 1, 7, 8, 9, 15, 16, 17, 31, 33, 100, 768, 1000, 1023};
+  const int64_t max_len = 1024;
+  std::mt19937 gen(20240601);
+  std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+  std::vector<float> a(max_len);
+  std::vector<float> b(max_len);
+  for (int64_t i = 0; i < max_len; i++) {
+    a[i] = dist(gen);
+    b[i] = dist(gen);
+  }
+  LOG_INFO("distance kernels", K(kernels_.cnt_));
+  for (int64_t i = 0; i < ARRAYSIZEOF(lens); i++) {
+    check_equal(a.data(), b.data(), lens[i]);
+  }
+  // the kernels read from unaligned addresses
+  check_equal(a.data() + 1, b.data() + 3, 100);
+}
+
+TEST_F(TestVectorDistance, overflow)
+{
+  const int64_t len = 35;
+  std::vector<float> a(len, 1.0f);
+  std::vector<float> b(len, 1.0f);
+  // products of both signs overflow in different lanes, which sum up to NaN instead of inf
+  for (int64_t i = 0; i < len; i++) {
+    a[i] = FLT_MAX;
+    b[i] = (0 == (i / 8) % 2) ? FLT_MAX : -FLT_MAX;
+  }
+  check_overflow(a.data(), b.data(), len);
+
+  // only the first lane overflows
+  std::fill(a.begin(), a.end(), 1.0f);
+  std::fill(b.begin(), b.end(), 1.0f);
+  a[0] = FLT_MAX;
+  b[0] = -FLT_MAX;
+  check_overflow(a.data(), b.data(), len);
+
+  // the overflow is in the scalar tail
+  a[0] = 1.0f;
+  b[0] = 1.0f;
+  a[len - 1] = FLT_MAX;
+  b[len - 1] = -FLT_MAX;
+  check_overflow(a.data(), b.data(), len);
+}
+
+TEST_F(TestVectorDistance, overflow_keeps_result)
+{
+  const int64_t len = 16;
+  std::vector<float> a(len, FLT_MAX);
+  std::vector<float> b(len, -FLT_MAX);
+  for (int64_t k = 0; k < kernels_.cnt_; k++) {
+    double l2 = 1.0;
+    double ip = 1.0;
+    EXPECT_EQ(OB_NUMERIC_OVERFLOW, kernels_.l2_[k](a.data(), b.data(), len, l2));
+    EXPECT_EQ(OB_NUMERIC_OVERFLOW, kernels_.ip_[k](a.data(), b.data(), len, ip));
+    if (0 != k) {
+      // the simd kernels do not write out a non-finite result
+      EXPECT_EQ(1.0, l2) << kernels_.name_[k];
+      EXPECT_EQ(1.0, ip) << kernels_.name_[k];
+    }
+  }
+}
+
+} // namespace common
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_vector_distance.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}